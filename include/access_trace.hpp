@@ -0,0 +1,106 @@
+/***************************************************************************
+ *            access_trace.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file access_trace.hpp
+ *  \brief Binary traces of the labels accessed in a cache, for offline analysis
+ */
+
+#ifndef HELPER_ACCESS_TRACE_HPP
+#define HELPER_ACCESS_TRACE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+#include "mapped_file.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A writer of the accesses to a cache as a binary file of 64-bit label hashes
+//! \details Hashes rather than labels are recorded, which keeps each access at 8 bytes and is all that is needed to
+//! reconstruct reuse distances. Hashes are mixed before being recorded, so that a weak hash function such as the identity
+//! on integers still yields uniformly distributed keys for spatial sampling. Accesses are buffered and appended to the file,
+//! hence traces from successive runs can be concatenated. Not thread-safe.
+class AccessTraceWriter {
+  public:
+    //! \brief Open the trace at \a path for appending, creating it if missing
+    AccessTraceWriter(std::string const& path);
+    AccessTraceWriter(AccessTraceWriter const&) = delete;
+    AccessTraceWriter& operator=(AccessTraceWriter const&) = delete;
+    ~AccessTraceWriter();
+
+    //! \brief Record an access to a label with the given \a hash
+    void record(std::uint64_t hash) {
+        _buffer.push_back(mix(hash));
+        if (_buffer.size() == BUFFER_SIZE) flush();
+    }
+
+    //! \brief Write the buffered accesses to the file
+    void flush();
+
+    //! \brief The number of accesses recorded by this writer
+    size_t number_of_accesses() const { return _number_of_accesses + _buffer.size(); }
+
+    //! \brief The finaliser of SplitMix64, spreading the bits of \a hash
+    static std::uint64_t mix(std::uint64_t hash) {
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        return hash ^ (hash >> 31);
+    }
+
+  private:
+    static constexpr size_t BUFFER_SIZE = 1 << 13;
+    std::ofstream _stream;
+    std::vector<std::uint64_t> _buffer;
+    size_t _number_of_accesses;
+};
+
+//! \brief A reader of a trace written by AccessTraceWriter, which is memory-mapped rather than read
+//! \details A missing or malformed file yields an invalid reader with no keys.
+class AccessTraceReader {
+  public:
+    //! \brief Open the trace at \a path
+    AccessTraceReader(std::string const& path);
+
+    //! \brief Whether the file is a valid trace
+    bool is_valid() const { return _valid; }
+    //! \brief The mixed label hashes in order of access
+    std::span<std::uint64_t const> keys() const { return _keys; }
+
+  private:
+    MappedFile _file;
+    std::span<std::uint64_t const> _keys;
+    bool _valid;
+};
+
+} // namespace Helper
+
+#endif // HELPER_ACCESS_TRACE_HPP
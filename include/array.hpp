@@ -39,6 +39,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <cassert>
+#include <vector>
 #include "metaprogramming.hpp"
 
 namespace Helper {
@@ -103,6 +104,13 @@ public:
         assert(std::distance(first,last) >= 0);
         this->_uninitialized_fill(first); }
 
+    //! \brief Constructs an Array from the single-pass range \a first to \a last, such as the elements of a Generator.
+    template<class InputIterator> requires std::input_iterator<InputIterator> and (not std::forward_iterator<InputIterator>)
+    Array(InputIterator first, InputIterator last) : _size(0), _ptr(0) {
+        std::vector<T> buffer(first,last);
+        _ptr=uninitialized_new(buffer.size()); _size=buffer.size();
+        this->_uninitialized_fill(std::make_move_iterator(buffer.begin())); }
+
     //! \brief Conversion constructor.
     template<class TT> requires Convertible<TT,T>
     Array(const Array<TT>& a) : _size(a.size()), _ptr(uninitialized_new(_size)) {
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *            cache_statistics.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file cache_statistics.hpp
+ *  \brief Counters of the activity of a cache, to be read as a snapshot
+ *  \details The counters are compiled out if HELPER_DISABLE_CACHE_STATISTICS is defined, which must then hold for all translation units.
+ */
+
+#ifndef HELPER_CACHE_STATISTICS_HPP
+#define HELPER_CACHE_STATISTICS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A snapshot of the counters of a cache
+//! \details The age of an evicted element is the number of insertions into the cache since the element was inserted.
+//! Latencies are in nanoseconds and are sampled on a fraction of the lookups only, if enabled.
+struct CacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    uint64_t expirations = 0;
+    uint64_t total_evicted_age = 0;
+    uint64_t maximum_evicted_age = 0;
+    uint64_t latency_samples = 0;
+    uint64_t total_latency = 0;
+    uint64_t maximum_latency = 0;
+
+    //! \brief The ratio of hits over all lookups, zero if no lookup was made
+    double hit_ratio() const { return _ratio(hits,hits+misses); }
+    //! \brief The average age of the evicted elements
+    double average_evicted_age() const { return _ratio(total_evicted_age,evictions); }
+    //! \brief The average sampled latency in nanoseconds
+    double average_latency() const { return _ratio(total_latency,latency_samples); }
+
+    //! \brief Merge with the statistics of another cache, such as another shard
+    CacheStatistics& operator+=(CacheStatistics const& other) {
+        hits += other.hits; misses += other.misses; insertions += other.insertions;
+        evictions += other.evictions; expirations += other.expirations;
+        total_evicted_age += other.total_evicted_age; maximum_evicted_age = std::max(maximum_evicted_age,other.maximum_evicted_age);
+        latency_samples += other.latency_samples; total_latency += other.total_latency; maximum_latency = std::max(maximum_latency,other.maximum_latency);
+        return *this;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, CacheStatistics const& s) {
+        return os << "{hits:" << s.hits << ", misses:" << s.misses << ", insertions:" << s.insertions << ", evictions:" << s.evictions
+                  << ", expirations:" << s.expirations << ", average evicted age:" << s.average_evicted_age()
+                  << ", average latency:" << s.average_latency() << "ns, maximum latency:" << s.maximum_latency << "ns}";
+    }
+
+  private:
+    static double _ratio(uint64_t n, uint64_t d) { return (d == 0 ? 0.0 : static_cast<double>(n)/static_cast<double>(d)); }
+};
+
+#ifndef HELPER_DISABLE_CACHE_STATISTICS
+
+//! \brief The counters of a cache, written by one thread at a time and readable from any thread
+//! \details Counters are relaxed atomics updated with a plain load and store, which compile to ordinary increments:
+//! writers must hence be serialised, as they are by the cache or its shard lock, while readers need no synchronisation.
+class CacheCounters {
+    using ClockType = std::chrono::steady_clock;
+    using CounterType = std::atomic<uint64_t>;
+  public:
+    //! \brief A latency measurement, recorded on destruction if the lookup was selected for sampling
+    class LatencySample {
+      public:
+        LatencySample(CacheCounters& counters) : _counters(counters), _sampled(counters._is_sampled()) {
+            if (_sampled) _start = ClockType::now(); }
+        ~LatencySample() {
+            if (_sampled) _counters._record_latency(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now()-_start).count())); }
+      private:
+        CacheCounters& _counters;
+        bool const _sampled;
+        ClockType::time_point _start;
+    };
+
+    //! \brief The insertion count when an element was inserted, used as a logical clock for ages
+    struct Stamp { uint64_t insertion_index = 0; };
+
+    CacheCounters() = default;
+    CacheCounters(CacheCounters const& other) { *this = other; }
+    CacheCounters& operator=(CacheCounters const& other) {
+        _store(_hits,other._hits); _store(_misses,other._misses); _store(_insertions,other._insertions);
+        _store(_evictions,other._evictions); _store(_expirations,other._expirations);
+        _store(_total_evicted_age,other._total_evicted_age); _store(_maximum_evicted_age,other._maximum_evicted_age);
+        _store(_latency_samples,other._latency_samples); _store(_total_latency,other._total_latency); _store(_maximum_latency,other._maximum_latency);
+        _latency_sampling_period = other._latency_sampling_period; _lookups = other._lookups;
+        return *this;
+    }
+
+    void hit(uint64_t n = 1) { _add(_hits,n); }
+    void miss(uint64_t n = 1) { _add(_misses,n); }
+    void insertion() { _increment(_insertions); }
+    void expiration() { _increment(_expirations); }
+    //! \brief Record an eviction of an element inserted with the given \a stamp
+    void eviction(Stamp stamp) {
+        _increment(_evictions);
+        uint64_t age = _insertions.load(std::memory_order_relaxed)-stamp.insertion_index;
+        _add(_total_evicted_age,age);
+        if (age > _maximum_evicted_age.load(std::memory_order_relaxed)) _maximum_evicted_age.store(age,std::memory_order_relaxed);
+    }
+
+    //! \brief The stamp for an element inserted now
+    Stamp stamp() const { return Stamp({_insertions.load(std::memory_order_relaxed)}); }
+
+    //! \brief Sample the latency of one lookup every \a period ones, or none if \a period is zero
+    void set_latency_sampling_period(size_t period) { _latency_sampling_period = period; _lookups = 0; }
+
+    //! \brief A snapshot of the counters
+    CacheStatistics statistics() const {
+        CacheStatistics result;
+        result.hits = _hits.load(std::memory_order_relaxed);
+        result.misses = _misses.load(std::memory_order_relaxed);
+        result.insertions = _insertions.load(std::memory_order_relaxed);
+        result.evictions = _evictions.load(std::memory_order_relaxed);
+        result.expirations = _expirations.load(std::memory_order_relaxed);
+        result.total_evicted_age = _total_evicted_age.load(std::memory_order_relaxed);
+        result.maximum_evicted_age = _maximum_evicted_age.load(std::memory_order_relaxed);
+        result.latency_samples = _latency_samples.load(std::memory_order_relaxed);
+        result.total_latency = _total_latency.load(std::memory_order_relaxed);
+        result.maximum_latency = _maximum_latency.load(std::memory_order_relaxed);
+        return result;
+    }
+
+  private:
+    static void _store(CounterType& c, CounterType const& other) { c.store(other.load(std::memory_order_relaxed),std::memory_order_relaxed); }
+    static void _add(CounterType& c, uint64_t n) { c.store(c.load(std::memory_order_relaxed)+n,std::memory_order_relaxed); }
+    static void _increment(CounterType& c) { _add(c,1); }
+
+    bool _is_sampled() { return _latency_sampling_period > 0 and ++_lookups % _latency_sampling_period == 0; }
+    void _record_latency(uint64_t latency) {
+        _increment(_latency_samples);
+        _add(_total_latency,latency);
+        if (latency > _maximum_latency.load(std::memory_order_relaxed)) _maximum_latency.store(latency,std::memory_order_relaxed);
+    }
+
+  private:
+    CounterType _hits = 0;
+    CounterType _misses = 0;
+    CounterType _insertions = 0;
+    CounterType _evictions = 0;
+    CounterType _expirations = 0;
+    CounterType _total_evicted_age = 0;
+    CounterType _maximum_evicted_age = 0;
+    CounterType _latency_samples = 0;
+    CounterType _total_latency = 0;
+    CounterType _maximum_latency = 0;
+    size_t _latency_sampling_period = 0;
+    size_t _lookups = 0;
+};
+
+#else /* HELPER_DISABLE_CACHE_STATISTICS */
+
+class CacheCounters {
+  public:
+    struct LatencySample { LatencySample(CacheCounters&) { } };
+    struct Stamp { };
+    void hit(uint64_t = 1) { }
+    void miss(uint64_t = 1) { }
+    void insertion() { }
+    void expiration() { }
+    void eviction(Stamp) { }
+    Stamp stamp() const { return Stamp(); }
+    void set_latency_sampling_period(size_t) { }
+    CacheStatistics statistics() const { return CacheStatistics(); }
+};
+
+#endif /* HELPER_DISABLE_CACHE_STATISTICS */
+
+} // namespace Helper
+
+#endif // HELPER_CACHE_STATISTICS_HPP
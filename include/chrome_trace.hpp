@@ -0,0 +1,83 @@
+/***************************************************************************
+ *            chrome_trace.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file chrome_trace.hpp
+ *  \brief Export of profiling zones and stopwatch intervals in the Chrome Trace Event format, as read by Perfetto
+ */
+
+#ifndef HELPER_CHROME_TRACE_HPP
+#define HELPER_CHROME_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "profile_zone.hpp"
+#include "stopwatch.hpp"
+
+namespace Helper {
+
+//! \brief A collection of timed events of several threads, to be written as a Chrome Trace Event JSON file
+//! \details Zones become pairs of begin and end events, which viewers nest by time within each thread, and stopwatch intervals
+//! become complete events. Threads are identified by their index in ZoneProfiler. Times are in microseconds from the earliest
+//! event; time points of clocks other than CycleClock are converted by the offset between the clocks when added.
+class ChromeTrace {
+    struct Event {
+        std::string name;
+        char phase;
+        size_t thread_index;
+        std::int64_t time;
+        std::int64_t duration;
+    };
+  public:
+    //! \brief Add the zones recorded by \a profiler; exits with no matching entry, as after a clear, are skipped
+    void add_zones(ZoneProfiler const& profiler = ZoneProfiler::instance());
+
+    //! \brief Add the interval between the restart and the last click of \a sw, on the thread with index \a thread_index
+    template<class D, class C> void add_interval(std::string name, Stopwatch<D,C> const& sw,
+                                                 size_t thread_index = ZoneProfiler::instance().thread_index()) {
+        auto offset = CycleClock::now().time_since_epoch() - std::chrono::duration_cast<CycleClock::duration>(C::now().time_since_epoch());
+        auto start = std::chrono::duration_cast<CycleClock::duration>(sw.initial().time_since_epoch()) + offset;
+        auto duration = std::chrono::duration_cast<CycleClock::duration>(sw.clicked()-sw.initial());
+        _events.push_back(Event{std::move(name), 'X', thread_index, start.count(), duration.count()});
+    }
+
+    //! \brief The number of events added
+    size_t number_of_events() const { return _events.size(); }
+
+    //! \brief Write the trace to \a path, through a buffer flushed in large chunks
+    //! \return Whether the file was written successfully
+    bool write(std::string const& path) const;
+
+  private:
+    std::vector<Event> _events;
+};
+
+} // namespace Helper
+
+#endif // HELPER_CHROME_TRACE_HPP
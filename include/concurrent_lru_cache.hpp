@@ -0,0 +1,299 @@
+/***************************************************************************
+ *            concurrent_lru_cache.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file concurrent_lru_cache.hpp
+ *  \brief A thread-safe Least Recently Used cache partitioned into independently locked shards
+ */
+
+#ifndef HELPER_CONCURRENT_LRU_CACHE_HPP
+#define HELPER_CONCURRENT_LRU_CACHE_HPP
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "lru_cache.hpp"
+
+namespace Helper {
+
+//! \brief A thread-safe cache of objects of type \a V indexed by a label \a L, partitioned into shards
+//! \details Each label is assigned to a shard by its hash, and each shard is an LRUCache guarded by its own mutex,
+//! so that accesses to labels in different shards do not serialise. Recency is tracked within each shard, hence
+//! eviction is least recently used per shard rather than globally. Values are returned by copy, since a reference
+//! into a shard could be invalidated by a concurrent eviction. Concurrent misses on the same label through
+//! get_or_compute are deduplicated, so that only one caller computes the value while the others wait for it.
+//! Each shard has its own instance of the eviction policy \a P.
+template<class L, class V, class P = LRUEviction<L>, class H = std::hash<L>> class ConcurrentLRUCache {
+  private:
+    struct alignas(64) Shard {
+        Shard(size_t maximum_size) : cache(maximum_size) { }
+        mutable std::mutex mutex;
+        LRUCache<L,V,P,H> cache;
+        std::unordered_map<L,std::shared_future<V>,H> in_flight;
+    };
+  public:
+    //! \brief Construct with a given \a maximum_size, split evenly among \a number_of_shards
+    //! \details Each shard holds at least one element, hence the effective capacity is rounded up to a multiple of the number of shards
+    ConcurrentLRUCache(size_t maximum_size, size_t number_of_shards = 16) : _maximum_size(maximum_size) {
+        HELPER_PRECONDITION(maximum_size>0);
+        HELPER_PRECONDITION(number_of_shards>0);
+        size_t shard_maximum_size = (maximum_size+number_of_shards-1)/number_of_shards;
+        _shards.reserve(number_of_shards);
+        for (size_t i=0; i<number_of_shards; ++i)
+            _shards.push_back(std::make_unique<Shard>(shard_maximum_size));
+    }
+
+    //! \brief Check whether the label is present
+    bool has_label(L const& label) const {
+        auto const& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.has_label(label);
+    }
+
+    //! \brief Get a copy of the element identified with \a label
+    //! \details Promotes the element to the most recently used one within its shard
+    V get(L const& label) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.get(label);
+    }
+
+    //! \brief Get a copy of the element identified with \a label, or nothing if not present
+    //! \details Unlike checking with has_label and then getting, the lookup is atomic
+    std::optional<V> try_get(L const& label) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto ptr = shard.cache.try_get(label);
+        if (ptr == nullptr) return std::nullopt;
+        return *ptr;
+    }
+
+    //! \brief Get copies of the elements identified with \a labels
+    //! \details The labels are grouped by shard, so that the lock of each shard is acquired once for the whole batch
+    BatchLookup<std::optional<V>> get_many(std::span<L const> labels) {
+        BatchLookup<std::optional<V>> result;
+        result.values.resize(labels.size());
+        auto batch = _group_by_shard(labels);
+        for (size_t s=0; s<_shards.size(); ++s) {
+            if (batch.offsets[s] == batch.offsets[s+1]) continue;
+            auto& shard = *_shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (size_t k=batch.offsets[s]; k<batch.offsets[s+1]; ++k) {
+                auto i = batch.order[k];
+                auto ptr = shard.cache.try_get(labels[i]);
+                if (ptr != nullptr) result.values[i] = *ptr;
+            }
+        }
+        for (size_t i=0; i<labels.size(); ++i)
+            if (not result.values[i].has_value()) result.misses.push_back(i);
+        return result;
+    }
+
+    //! \brief Get a copy of the element identified with \a label, inserting the result of \a factory if not present
+    //! \details The factory takes no arguments and returns a value convertible to \a V. It is run without holding
+    //! the lock of the shard, and only by the first caller missing on the label: other callers missing on the same label
+    //! block until the value is available. If the factory throws, the exception is propagated to all those callers
+    //! and nothing is inserted.
+    template<class F> V get_or_compute(L const& label, F const& factory) {
+        auto& shard = _shard(label);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        if (shard.cache.has_label(label)) return shard.cache.get(label);
+        auto f = shard.in_flight.find(label);
+        if (f != shard.in_flight.end()) {
+            auto future = f->second;
+            lock.unlock();
+            return future.get();
+        }
+        std::promise<V> promise;
+        shard.in_flight.emplace(label,promise.get_future().share());
+        lock.unlock();
+        try {
+            V val = factory();
+            lock.lock();
+            if (not shard.cache.has_label(label)) shard.cache.put(label,val);
+            shard.in_flight.erase(label);
+            lock.unlock();
+            promise.set_value(val);
+            return val;
+        } catch (...) {
+            if (not lock.owns_lock()) lock.lock();
+            shard.in_flight.erase(label);
+            lock.unlock();
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    //! \brief Insert the element
+    //! \details The element must not already exist; evicts the least recently used element of the shard if the shard is full.
+    //! An rvalue \a val is moved into the cache rather than copied
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.put(label,std::forward<VV>(val));
+    }
+
+    //! \brief Insert the element, expiring after \a time_to_live
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val, typename LRUCache<L,V,P,H>::DurationType time_to_live) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.put(label,std::forward<VV>(val),time_to_live);
+    }
+
+    //! \brief Insert the elements with \a labels and respective \a values
+    //! \details The elements must not already exist; the lock of each shard is acquired once for the whole batch
+    void put_many(std::span<L const> labels, std::span<V const> values) {
+        HELPER_PRECONDITION(labels.size() == values.size());
+        auto batch = _group_by_shard(labels);
+        for (size_t s=0; s<_shards.size(); ++s) {
+            if (batch.offsets[s] == batch.offsets[s+1]) continue;
+            auto& shard = *_shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (size_t k=batch.offsets[s]; k<batch.offsets[s+1]; ++k)
+                shard.cache.put(labels[batch.order[k]],values[batch.order[k]]);
+        }
+    }
+
+    //! \brief Insert the element constructed in place from \a args
+    //! \details The element must not already exist; the value is constructed exactly once while holding the lock of the shard
+    template<class... AS> void emplace(L const& label, AS&&... args) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.emplace(label,std::forward<AS>(args)...);
+    }
+
+    //! \brief Remove the element identified with \a label, if present
+    //! \return Whether an element was removed
+    bool erase(L const& label) {
+        auto& shard = _shard(label);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.erase(label);
+    }
+
+    //! \brief Remove all the expired elements, one shard at a time
+    void expire() {
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->cache.expire();
+        }
+    }
+
+    //! \brief The current size due to putting elements, summed over all shards
+    size_t current_size() const {
+        size_t result = 0;
+        for (auto const& shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            result += shard->cache.current_size();
+        }
+        return result;
+    }
+
+    //! \brief The maximum size as initially supplied
+    size_t maximum_size() const {
+        return _maximum_size;
+    }
+
+    //! \brief The number of shards
+    size_t number_of_shards() const {
+        return _shards.size();
+    }
+
+    //! \brief The current size of each shard
+    std::vector<size_t> shard_sizes() const {
+        std::vector<size_t> result;
+        result.reserve(_shards.size());
+        for (auto const& shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            result.push_back(shard->cache.current_size());
+        }
+        return result;
+    }
+
+    //! \brief A snapshot of the counters, merged over all shards
+    //! \details Does not lock the shards, hence counters may be mutually inconsistent while the cache is in use
+    CacheStatistics statistics() const {
+        CacheStatistics result;
+        for (auto const& shard : _shards) result += shard->cache.statistics();
+        return result;
+    }
+
+    //! \brief Sample the latency of one lookup every \a period ones in each shard, or none if \a period is zero
+    void set_latency_sampling_period(size_t period) {
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->cache.set_latency_sampling_period(period);
+        }
+    }
+
+    //! \brief The maximum size of each shard
+    size_t shard_maximum_size() const {
+        return _shards.front()->cache.maximum_size();
+    }
+
+  private:
+    //! \brief Select the shard from the high bits of the mixed hash, to keep them uncorrelated from the buckets within the shard
+    size_t _shard_index(L const& label) const {
+        uint64_t mixed = static_cast<uint64_t>(H()(label)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>((mixed >> 32) % _shards.size());
+    }
+    //! \brief The indices of a batch of labels sorted by shard, where the indices for shard \a s range from \a offsets[s] to \a offsets[s+1]
+    struct ShardBatch {
+        std::vector<size_t> order;
+        std::vector<size_t> offsets;
+    };
+
+    ShardBatch _group_by_shard(std::span<L const> labels) const {
+        ShardBatch result;
+        result.offsets.assign(_shards.size()+1,0);
+        std::vector<size_t> indices(labels.size());
+        for (size_t i=0; i<labels.size(); ++i) {
+            indices[i] = _shard_index(labels[i]);
+            ++result.offsets[indices[i]+1];
+        }
+        for (size_t s=0; s<_shards.size(); ++s) result.offsets[s+1] += result.offsets[s];
+        result.order.resize(labels.size());
+        auto next = result.offsets;
+        for (size_t i=0; i<labels.size(); ++i) result.order[next[indices[i]]++] = i;
+        return result;
+    }
+
+    Shard& _shard(L const& label) { return *_shards[_shard_index(label)]; }
+    Shard const& _shard(L const& label) const { return *_shards[_shard_index(label)]; }
+
+  private:
+    size_t _maximum_size;
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
+
+} // namespace Helper
+
+#endif // HELPER_CONCURRENT_LRU_CACHE_HPP
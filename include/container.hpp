@@ -246,31 +246,43 @@ template<class T> ostream& operator<<(ostream& os, const std::set<T>& v) {
 }
 
 
-template<class K, class T> class Map : public std::map<K,T> {
+//! \brief Whether a key of type \a KK can be compared with keys of type \a K directly, so that a map can be searched without constructing a \a K
+template<class KK, class K> concept HeterogeneousKey = not SameAs<KK,K> and requires(KK const& kk, K const& k) {
+    { kk < k } -> ConvertibleTo<bool>;
+    { k < kk } -> ConvertibleTo<bool>; };
+
+//! \brief Whether the comparator \a C is transparent, so that a map using it can be searched with keys of other types
+template<class C> concept TransparentComparator = requires { typename C::is_transparent; };
+
+//! \brief A map ordered by the comparator \a C
+//! \details With the default comparator, a Map<K,T> is a std::map<K,T>. With a transparent comparator such as \c std::less<>,
+//! lookups also accept any key type comparable with \a K, without constructing a \a K.
+template<class K, class T, class C = std::less<K>> class Map : public std::map<K,T,C> {
+    typedef std::map<K,T,C> MapType;
   public:
-    typedef typename std::map<K,T>::iterator Iterator;
-    typedef typename std::map<K,T>::const_iterator ConstIterator;
-    template<ConvertibleTo<T> TT>
-        Map(const std::map<K,TT>& m) : std::map<K,T>(m.begin(),m.end()) { }
-    using std::map<K,T>::map;
-    using std::map<K,T>::insert;
-    T& operator[](K k) { return this->std::map<K,T>::operator[](k); }
+    typedef typename MapType::iterator Iterator;
+    typedef typename MapType::const_iterator ConstIterator;
+    template<ConvertibleTo<T> TT, class CC>
+        Map(const std::map<K,TT,CC>& m) : MapType(m.begin(),m.end()) { }
+    using MapType::map;
+    using MapType::insert;
+    T& operator[](K k) { return this->MapType::operator[](k); }
     const T& operator[](K k) const { auto iter=this->find(k); HELPER_ASSERT(iter!=this->end()); return iter->second; }
-    const T& get(const K& k) const { auto i=this->find(k);
-        HELPER_ASSERT(i!=this->end()); return i->second; }
+    const T& get(const K& k) const { return _get(k); }
+    template<HeterogeneousKey<K> KK> requires TransparentComparator<C> const T& get(const KK& k) const { return _get(k); }
     bool has_key(const K& k) const {
         return this->find(k)!=this->end(); }
-    T& value(const K& k) {
-        auto iter=this->find(k);
-        HELPER_ASSERT(iter!=this->end()); return iter->second; }
-    const T& value(const K& k) const {
-        auto iter=this->find(k);
-        HELPER_ASSERT(iter!=this->end()); return iter->second; }
+    template<HeterogeneousKey<K> KK> requires TransparentComparator<C> bool has_key(const KK& k) const {
+        return this->find(k)!=this->end(); }
+    T& value(const K& k) { return _value(k); }
+    template<HeterogeneousKey<K> KK> requires TransparentComparator<C> T& value(const KK& k) { return _value(k); }
+    const T& value(const K& k) const { return _get(k); }
+    template<HeterogeneousKey<K> KK> requires TransparentComparator<C> const T& value(const KK& k) const { return _get(k); }
     void insert(const std::pair<K,T>& kv) {
-        this->std::map<K,T>::insert(kv); }
+        this->MapType::insert(kv); }
     void insert(const K& k, const T& v) {
-        this->std::map<K,T>::insert(std::make_pair(k,v)); }
-    void adjoin(const std::map<K,T>& m) {
+        this->MapType::insert(std::make_pair(k,v)); }
+    template<class CC> void adjoin(const std::map<K,T,CC>& m) {
         for(auto i=m.begin(); i!=m.end(); ++i) { this->insert(*i); } }
     void remove_keys(const Set<K>& s) {
         for(auto iter=s.begin(); iter!=s.end(); ++iter) { this->erase(*iter); } }
@@ -280,16 +292,23 @@ template<class K, class T> class Map : public std::map<K,T> {
     List<T> values() const {
         List<T> res; for(auto iter=this->begin(); iter!=this->end(); ++iter) {
             res.append(iter->second); } return res; }
+  private:
+    template<class KK> const T& _get(const KK& k) const {
+        auto iter=this->find(k);
+        HELPER_ASSERT(iter!=this->end()); return iter->second; }
+    template<class KK> T& _value(const KK& k) {
+        auto iter=this->find(k);
+        HELPER_ASSERT(iter!=this->end()); return iter->second; }
 };
-template<class K, class T> inline Map<K,T> join(Map<K,T> m1, Map<K,T> const& m2) {
+template<class K, class T, class C> inline Map<K,T,C> join(Map<K,T,C> m1, Map<K,T,C> const& m2) {
     m1.adjoin(m2); return m1; }
-template<class I, class X, class J> inline X& insert(Map<I,X>& m, const J& k, const X& v) {
-    return m.std::template map<I,X>::insert(std::make_pair(k,v)).first->second; }
-template<class K, class T> Map<K,T> restrict_keys(const std::map<K,T>& m, const std::set<K>& k) {
-    Map<K,T> result; const Set<K>& keys=static_cast<const Set<K>&>(k);
+template<class I, class X, class C, class J> inline X& insert(Map<I,X,C>& m, const J& k, const X& v) {
+    return m.std::template map<I,X,C>::insert(std::make_pair(k,v)).first->second; }
+template<class K, class T, class C, class D> Map<K,T> restrict_keys(const std::map<K,T,C>& m, const std::set<K,D>& k) {
+    Map<K,T> result;
     for(auto item_iter=m.begin(); item_iter!=m.end(); ++item_iter) {
-        if(keys.contains(item_iter->first)) { result.insert(*item_iter); } } return result; }
-template<class K, class T> ostream& operator<<(ostream& os, const std::map<K,T>& m) {
+        if(k.find(item_iter->first)!=k.end()) { result.insert(*item_iter); } } return result; }
+template<class K, class T, class C> ostream& operator<<(ostream& os, const std::map<K,T,C>& m) {
     bool first=true;
     for(auto x : m) {
         os << (first ? "{ " : ", ") << x.first << ":" << x.second;
@@ -0,0 +1,104 @@
+/***************************************************************************
+ *            cycle_clock.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file cycle_clock.hpp
+ *  \brief A clock reading the CPU time stamp counter, for timing very short intervals
+ */
+
+#ifndef HELPER_CYCLE_CLOCK_HPP
+#define HELPER_CYCLE_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) or defined(__i386__) or defined(_M_X64) or defined(_M_IX86)
+#define HELPER_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define HELPER_HAS_TSC 0
+#endif
+
+namespace Helper {
+
+//! \brief A steady clock reading the time stamp counter of the CPU, converted to nanoseconds
+//! \details Reading the counter takes a few nanoseconds, against a few tens for the system clocks. The counter is used only when
+//! invariant, that is, ticking at a constant rate across frequency changes and sleep states and synchronised across cores; the
+//! rate is calibrated once against \c std::chrono::steady_clock, on the first call. Otherwise, as on processors other than x86
+//! or on virtual machines hiding the invariant flag, the steady clock is read instead. Time points share the epoch of the steady
+//! clock in either case.
+class CycleClock {
+  public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<CycleClock>;
+    static constexpr bool is_steady = true;
+
+    //! \brief The current time
+    static time_point now() noexcept {
+#if HELPER_HAS_TSC
+        Calibration const& c = calibration();
+        if (c.invariant) {
+            std::uint64_t ticks = __rdtsc();
+            std::uint64_t delta = ticks > c.base_ticks ? ticks - c.base_ticks : 0;
+            // Multiply by a 32.32 fixed-point factor in two halves, which does not overflow for any practical delta
+            std::uint64_t nanoseconds = (delta >> 32)*c.factor + (((delta & 0xFFFFFFFFull)*c.factor) >> 32);
+            return time_point(duration(c.base_nanoseconds + static_cast<rep>(nanoseconds)));
+        }
+#endif
+        return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+    }
+
+    //! \brief Whether the time stamp counter is read, rather than the steady clock
+    static bool uses_time_stamp_counter() { return calibration().invariant; }
+    //! \brief The calibrated number of ticks of the time stamp counter per second, or zero if not used
+    static double ticks_per_second() { return calibration().invariant ? 4294967296.0e9/static_cast<double>(calibration().factor) : 0.0; }
+
+  private:
+    struct Calibration {
+        bool invariant;
+        std::uint64_t base_ticks;
+        rep base_nanoseconds;
+        //! \brief Nanoseconds per tick, times 2^32
+        std::uint64_t factor;
+    };
+    //! \brief Detect an invariant counter and measure its rate
+    static Calibration calibrate();
+    static Calibration const& calibration() {
+        static Calibration const result = calibrate();
+        return result;
+    }
+};
+
+} // namespace Helper
+
+#endif // HELPER_CYCLE_CLOCK_HPP
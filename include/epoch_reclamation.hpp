@@ -0,0 +1,110 @@
+/***************************************************************************
+ *            epoch_reclamation.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file epoch_reclamation.hpp
+ *  \brief Deferred reclamation of memory read by lock-free readers, based on epochs
+ */
+
+#ifndef HELPER_EPOCH_RECLAMATION_HPP
+#define HELPER_EPOCH_RECLAMATION_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief The process-wide domain of epoch-based reclamation
+//! \details Readers access shared objects within a Guard, which publishes the epoch at which the reader entered in a record owned
+//! by its thread, hence readers write no cache line shared with other threads. Writers first make an object unreachable and then
+//! retire it: retiring advances the epoch, and the object is deleted once every reader has left the epochs in which it could have
+//! obtained a pointer to the object. Guards can be nested. Retiring is serialised by a mutex, hence meant for infrequent writes.
+class EpochDomain {
+  public:
+    //! \brief A scope within which pointers loaded from shared structures stay valid
+    class Guard {
+      public:
+        Guard();
+        ~Guard();
+        Guard(Guard const&) = delete;
+        Guard& operator=(Guard const&) = delete;
+    };
+
+    //! \brief The domain
+    static EpochDomain& instance();
+
+    EpochDomain(EpochDomain const&) = delete;
+    EpochDomain& operator=(EpochDomain const&) = delete;
+    //! \brief Delete all the retired objects, assuming that no reader is left
+    ~EpochDomain();
+
+    //! \brief Delete \a ptr once no reader can hold it any more
+    //! \details The object must already be unreachable to readers entering from now on
+    template<class T> void retire(T* ptr) {
+        _retire(ptr, [](void* p){ delete static_cast<T*>(p); });
+    }
+
+    //! \brief Delete the retired objects that no reader can hold any more
+    void reclaim();
+
+    //! \brief The number of retired objects not deleted yet
+    size_t number_of_retired() const;
+
+  private:
+    struct alignas(64) Record {
+        //! \brief The epoch at which the owning thread entered, or zero if outside any guard
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> in_use{false};
+        Record* next{nullptr};
+    };
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+    friend class Guard;
+
+    EpochDomain();
+    Record* _acquire_record();
+    void _retire(void* pointer, void (*deleter)(void*));
+    void _reclaim();
+
+  private:
+    static constexpr size_t RECLAIM_THRESHOLD = 64;
+    alignas(64) std::atomic<std::uint64_t> _epoch;
+    alignas(64) std::atomic<Record*> _records;
+    mutable std::mutex _mutex;
+    std::vector<Retired> _retired;
+};
+
+} // namespace Helper
+
+#endif // HELPER_EPOCH_RECLAMATION_HPP
@@ -0,0 +1,339 @@
+/***************************************************************************
+ *            eviction_policy.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file eviction_policy.hpp
+ *  \brief Scan-resistant eviction policies to be used as a template parameter of LRUCache
+ */
+
+#ifndef HELPER_EVICTION_POLICY_HPP
+#define HELPER_EVICTION_POLICY_HPP
+
+#include <algorithm>
+#include <list>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <limits>
+#include <cstdint>
+#include "macros.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief Labels partitioned into \a N queues, each ordered from the most recently to the least recently pushed label
+//! \details All operations take amortized constant time. Used as the bookkeeping of the eviction policies.
+template<class L, class H, size_t N> class EvictionQueues {
+  private:
+    using QueueList = std::list<L const*>;
+    struct Position {
+        size_t queue;
+        typename QueueList::iterator iterator;
+    };
+  public:
+    //! \brief The value returned by queue_of for an absent label
+    static constexpr size_t NONE = N;
+
+    //! \brief The queue holding \a label, or NONE
+    size_t queue_of(L const& label) const {
+        auto p = _positions.find(label);
+        return (p == _positions.end() ? NONE : p->second.queue);
+    }
+
+    //! \brief The size of queue \a q
+    size_t size(size_t q) const { return _queues[q].size(); }
+    //! \brief Whether queue \a q is empty
+    bool empty(size_t q) const { return _queues[q].empty(); }
+    //! \brief The least recently pushed label of queue \a q
+    L const& back(size_t q) const { return *_queues[q].back(); }
+
+    //! \brief Push an absent \a label to the front of queue \a q
+    void push_front(size_t q, L const& label) {
+        auto p = _positions.emplace(label,Position({q,_queues[q].end()})).first;
+        _queues[q].push_front(&p->first);
+        p->second.iterator = _queues[q].begin();
+    }
+
+    //! \brief Move a present \a label to the front of queue \a q
+    void move_to_front(size_t q, L const& label) {
+        auto& position = _positions.find(label)->second;
+        _queues[q].splice(_queues[q].begin(), _queues[position.queue], position.iterator);
+        position.queue = q;
+    }
+
+    //! \brief Remove \a label, if present
+    void remove(L const& label) {
+        auto p = _positions.find(label);
+        if (p == _positions.end()) return;
+        _queues[p->second.queue].erase(p->second.iterator);
+        _positions.erase(p);
+    }
+
+    //! \brief Remove the least recently pushed label of queue \a q
+    void pop_back(size_t q) {
+        auto p = _positions.find(*_queues[q].back());
+        _queues[q].pop_back();
+        _positions.erase(p);
+    }
+
+  private:
+    std::array<QueueList,N> _queues;
+    std::unordered_map<L,Position,H> _positions;
+};
+
+//! \brief The 2Q eviction policy by Johnson and Shasha
+//! \details Labels inserted for the first time enter a FIFO queue taking a quarter of the cache, and are promoted
+//! to the main LRU queue only if inserted again while remembered in a ghost queue of recently evicted labels.
+//! A scan over cold labels hence only flushes the FIFO queue.
+template<class L, class H = std::hash<L>> class TwoQueueEviction {
+    enum Queue : size_t { IN, MAIN, OUT };
+  public:
+    TwoQueueEviction(size_t maximum_size) : _in_maximum_size(std::max<size_t>(1,maximum_size/4)), _out_maximum_size(std::max<size_t>(1,maximum_size/2)) {
+        HELPER_PRECONDITION_MSG(maximum_size<std::numeric_limits<size_t>::max(), "The 2Q eviction policy requires a bounded maximum size");
+    }
+
+    void on_hit(L const& label) {
+        if (_queues.queue_of(label) == MAIN) _queues.move_to_front(MAIN,label);
+    }
+
+    void on_miss(L const&) { }
+
+    L const& victim(L const&, L const&) const {
+        if (not _queues.empty(IN) and (_queues.size(IN) > _in_maximum_size or _queues.empty(MAIN))) return _queues.back(IN);
+        return _queues.back(MAIN);
+    }
+
+    void on_insert(L const& label) {
+        if (_queues.queue_of(label) == OUT) _queues.move_to_front(MAIN,label);
+        else _queues.push_front(IN,label);
+    }
+
+    void on_evict(L const& label) {
+        if (_queues.queue_of(label) == IN) {
+            _queues.move_to_front(OUT,label);
+            if (_queues.size(OUT) > _out_maximum_size) _queues.pop_back(OUT);
+        } else {
+            _queues.remove(label);
+        }
+    }
+
+    void on_erase(L const& label) {
+        _queues.remove(label);
+    }
+
+  private:
+    size_t const _in_maximum_size;
+    size_t const _out_maximum_size;
+    EvictionQueues<L,H,3> _queues;
+};
+
+//! \brief The Adaptive Replacement Cache policy by Megiddo and Modha
+//! \details Resident labels are split between a recency queue, for labels seen once, and a frequency queue, for labels
+//! seen at least twice. Ghost queues of labels evicted from each one adapt the target size of the recency queue
+//! to the workload, so that a scan only displaces labels seen once.
+template<class L, class H = std::hash<L>> class ARCEviction {
+    enum Queue : size_t { RECENT, FREQUENT, RECENT_GHOST, FREQUENT_GHOST };
+  public:
+    ARCEviction(size_t maximum_size) : _capacity(maximum_size), _recent_target(0) {
+        HELPER_PRECONDITION_MSG(maximum_size<std::numeric_limits<size_t>::max(), "The ARC eviction policy requires a bounded maximum size");
+    }
+
+    void on_hit(L const& label) {
+        _queues.move_to_front(FREQUENT,label);
+    }
+
+    void on_miss(L const& label) {
+        auto q = _queues.queue_of(label);
+        if (q == RECENT_GHOST) {
+            size_t delta = std::max<size_t>(1,_queues.size(FREQUENT_GHOST)/_queues.size(RECENT_GHOST));
+            _recent_target = std::min(_capacity,_recent_target+delta);
+        } else if (q == FREQUENT_GHOST) {
+            size_t delta = std::max<size_t>(1,_queues.size(RECENT_GHOST)/_queues.size(FREQUENT_GHOST));
+            _recent_target = (_recent_target > delta ? _recent_target-delta : 0);
+        }
+    }
+
+    L const& victim(L const& candidate, L const&) const {
+        size_t recent_size = _queues.size(RECENT);
+        bool candidate_in_frequent_ghost = (_queues.queue_of(candidate) == FREQUENT_GHOST);
+        if (recent_size > 0 and ((candidate_in_frequent_ghost and recent_size == _recent_target) or recent_size > _recent_target or _queues.empty(FREQUENT)))
+            return _queues.back(RECENT);
+        return _queues.back(FREQUENT);
+    }
+
+    void on_insert(L const& label) {
+        auto q = _queues.queue_of(label);
+        if (q == RECENT_GHOST or q == FREQUENT_GHOST) _queues.move_to_front(FREQUENT,label);
+        else _queues.push_front(RECENT,label);
+        _trim_ghosts();
+    }
+
+    void on_evict(L const& label) {
+        _queues.move_to_front(_queues.queue_of(label) == RECENT ? RECENT_GHOST : FREQUENT_GHOST,label);
+        _trim_ghosts();
+    }
+
+    void on_erase(L const& label) {
+        _queues.remove(label);
+    }
+
+    //! \brief The current target size of the recency queue
+    size_t recent_target() const { return _recent_target; }
+
+  private:
+    void _trim_ghosts() {
+        while (_queues.size(RECENT)+_queues.size(RECENT_GHOST) > _capacity and not _queues.empty(RECENT_GHOST))
+            _queues.pop_back(RECENT_GHOST);
+        while (_queues.size(RECENT)+_queues.size(FREQUENT)+_queues.size(RECENT_GHOST)+_queues.size(FREQUENT_GHOST) > 2*_capacity and not _queues.empty(FREQUENT_GHOST))
+            _queues.pop_back(FREQUENT_GHOST);
+    }
+
+  private:
+    size_t const _capacity;
+    size_t _recent_target;
+    EvictionQueues<L,H,4> _queues;
+};
+
+//! \brief An approximate counter of the recent frequency of labels, as a count-min sketch of saturating counters
+//! \details Counters are halved once the number of increments reaches ten times the number of counters per row,
+//! so that the frequencies decay over time.
+template<class L, class H = std::hash<L>> class FrequencySketch {
+    static constexpr size_t NUM_ROWS = 4;
+    static constexpr uint8_t MAXIMUM_COUNT = 15;
+  public:
+    FrequencySketch(size_t width) : _mask(_power_of_two_at_least(std::max<size_t>(16,width))-1), _counters(NUM_ROWS*(_mask+1),0), _additions(0) { }
+
+    //! \brief Increment the frequency of \a label
+    void increment(L const& label) {
+        auto hashes = _hashes(label);
+        for (size_t i=0; i<NUM_ROWS; ++i) {
+            auto& counter = _counters[_index(hashes,i)];
+            if (counter < MAXIMUM_COUNT) ++counter;
+        }
+        if (++_additions >= 10*(_mask+1)) _age();
+    }
+
+    //! \brief The estimated frequency of \a label
+    uint8_t frequency(L const& label) const {
+        auto hashes = _hashes(label);
+        uint8_t result = MAXIMUM_COUNT;
+        for (size_t i=0; i<NUM_ROWS; ++i) result = std::min(result,_counters[_index(hashes,i)]);
+        return result;
+    }
+
+  private:
+    static size_t _power_of_two_at_least(size_t n) { size_t result = 1; while (result < n) result <<= 1; return result; }
+    std::pair<uint64_t,uint64_t> _hashes(L const& label) const {
+        uint64_t h = static_cast<uint64_t>(H()(label));
+        uint64_t h1 = h * 0x9E3779B97F4A7C15ull;
+        uint64_t h2 = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9ull;
+        return {h1 ^ (h1 >> 32), (h2 ^ (h2 >> 32)) | 1};
+    }
+    size_t _index(std::pair<uint64_t,uint64_t> const& hashes, size_t row) const {
+        return row*(_mask+1) + static_cast<size_t>((hashes.first + row*hashes.second) & _mask);
+    }
+    void _age() {
+        for (auto& counter : _counters) counter = static_cast<uint8_t>(counter >> 1);
+        _additions /= 2;
+    }
+
+  private:
+    size_t const _mask;
+    std::vector<uint8_t> _counters;
+    size_t _additions;
+};
+
+//! \brief The W-TinyLFU eviction policy by Einziger, Friedman and Manes
+//! \details New labels enter a small LRU window. When the cache is full, the least recently used label of the window
+//! is admitted to the main segmented LRU only if its estimated frequency exceeds that of the main victim, so that
+//! labels seen once during a scan do not displace frequently used ones.
+template<class L, class H = std::hash<L>> class TinyLFUEviction {
+    enum Queue : size_t { WINDOW, PROBATION, PROTECTED };
+  public:
+    TinyLFUEviction(size_t maximum_size)
+        : _window_maximum_size(std::max<size_t>(1,maximum_size/100)), _protected_maximum_size((maximum_size-_window_maximum_size)*4/5),
+          _sketch(_checked_maximum_size(maximum_size)) { }
+
+    void on_hit(L const& label) {
+        _sketch.increment(label);
+        auto q = _queues.queue_of(label);
+        if (q == PROBATION) {
+            _queues.move_to_front(PROTECTED,label);
+            if (_queues.size(PROTECTED) > _protected_maximum_size) _queues.move_to_front(PROBATION,_queues.back(PROTECTED));
+        } else {
+            _queues.move_to_front(q,label);
+        }
+    }
+
+    void on_miss(L const& label) {
+        _sketch.increment(label);
+    }
+
+    L const& victim(L const&, L const&) {
+        if (_queues.size(WINDOW) >= _window_maximum_size) {
+            L const& window_victim = _queues.back(WINDOW);
+            if (_queues.empty(PROBATION) and _queues.empty(PROTECTED)) return window_victim;
+            L const& main_victim = _queues.back(_queues.empty(PROBATION) ? PROTECTED : PROBATION);
+            if (_sketch.frequency(window_victim) <= _sketch.frequency(main_victim)) return window_victim;
+            _queues.move_to_front(PROBATION,window_victim);
+            return main_victim;
+        }
+        if (not _queues.empty(PROBATION)) return _queues.back(PROBATION);
+        if (not _queues.empty(PROTECTED)) return _queues.back(PROTECTED);
+        return _queues.back(WINDOW);
+    }
+
+    void on_insert(L const& label) {
+        _queues.push_front(WINDOW,label);
+        while (_queues.size(WINDOW) > _window_maximum_size) _queues.move_to_front(PROBATION,_queues.back(WINDOW));
+    }
+
+    void on_evict(L const& label) {
+        _queues.remove(label);
+    }
+
+    void on_erase(L const& label) {
+        _queues.remove(label);
+    }
+
+  private:
+    static size_t _checked_maximum_size(size_t maximum_size) {
+        HELPER_PRECONDITION_MSG(maximum_size<std::numeric_limits<size_t>::max(), "The TinyLFU eviction policy requires a bounded maximum size");
+        return maximum_size;
+    }
+
+  private:
+    size_t const _window_maximum_size;
+    size_t const _protected_maximum_size;
+    FrequencySketch<L,H> _sketch;
+    EvictionQueues<L,H,3> _queues;
+};
+
+} // namespace Helper
+
+#endif // HELPER_EVICTION_POLICY_HPP
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *            generator.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file generator.hpp
+ *  \brief Lazy sequences whose elements are yielded on demand by a coroutine
+ */
+
+#ifndef HELPER_GENERATOR_HPP
+#define HELPER_GENERATOR_HPP
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+#if __has_include(<coroutine>) and defined(__cpp_impl_coroutine)
+#include <coroutine>
+namespace Helper { namespace Coroutine = std; }
+#elif __has_include(<experimental/coroutine>)
+#include <experimental/coroutine>
+namespace Helper { namespace Coroutine = std::experimental; }
+#else
+#error "Coroutines are not supported by the compiler"
+#endif
+
+namespace Helper {
+
+//! \brief A single-pass sequence of elements of type \a T, computed by a coroutine that \c co_yield s them one at a time
+//! \details The coroutine starts suspended and runs up to the next \c co_yield each time the iterator is advanced, hence only
+//! the current element is stored, regardless of the length of the sequence, which may be infinite. An exception thrown by the
+//! coroutine is rethrown by the call to \c begin or to the increment that resumed it. The sequence can be traversed with a
+//! range-based for loop, or collected with the iterator-pair constructors of List and Array. With \c -Wswitch-default, GCC warns
+//! at the end of the body of each coroutine, about the switch it generates.
+//! \code
+//! Generator<size_t> squares(size_t n) { for (size_t i=0; i<n; ++i) co_yield i*i; }
+//! \endcode
+template<class T> class Generator {
+  public:
+    struct promise_type {
+        Generator get_return_object() { return Generator(Coroutine::coroutine_handle<promise_type>::from_promise(*this)); }
+        Coroutine::suspend_always initial_suspend() const noexcept { return {}; }
+        Coroutine::suspend_always final_suspend() const noexcept { return {}; }
+        Coroutine::suspend_always yield_value(T element) {
+            value.emplace(std::move(element));
+            return {};
+        }
+        void return_void() const noexcept { }
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::optional<T> value;
+        std::exception_ptr exception;
+    };
+
+    using Handle = Coroutine::coroutine_handle<promise_type>;
+
+    //! \brief An input iterator over the elements, equal to the default-constructed end iterator once the coroutine returns
+    class Iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T const&;
+
+        Iterator() : _handle(nullptr) { }
+        explicit Iterator(Handle handle) : _handle(handle) { _advance(); }
+
+        reference operator*() const { return *_handle.promise().value; }
+        pointer operator->() const { return &*_handle.promise().value; }
+        Iterator& operator++() { _advance(); return *this; }
+        void operator++(int) { _advance(); }
+        friend bool operator==(Iterator const& it1, Iterator const& it2) { return it1._handle == it2._handle; }
+        friend bool operator!=(Iterator const& it1, Iterator const& it2) { return not (it1 == it2); }
+
+      private:
+        void _advance() {
+            _handle.resume();
+            if (_handle.done()) {
+                auto exception = _handle.promise().exception;
+                _handle = nullptr;
+                if (exception) std::rethrow_exception(exception);
+            }
+        }
+      private:
+        Handle _handle;
+    };
+
+    Generator(Generator const&) = delete;
+    Generator& operator=(Generator const&) = delete;
+    Generator(Generator&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) { }
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (_handle) _handle.destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+    ~Generator() { if (_handle) _handle.destroy(); }
+
+    //! \brief Start the traversal, running the coroutine up to its first element; can be called only once
+    Iterator begin() { return _handle ? Iterator(_handle) : Iterator(); }
+    //! \brief The end of the traversal
+    Iterator end() const { return Iterator(); }
+
+  private:
+    explicit Generator(Handle handle) : _handle(handle) { }
+  private:
+    Handle _handle;
+};
+
+} // namespace Helper
+
+#endif // HELPER_GENERATOR_HPP
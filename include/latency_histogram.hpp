@@ -0,0 +1,133 @@
+/***************************************************************************
+ *            latency_histogram.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file latency_histogram.hpp
+ *  \brief A high dynamic range histogram of durations, for reporting percentiles of latencies
+ */
+
+#ifndef HELPER_LATENCY_HISTOGRAM_HPP
+#define HELPER_LATENCY_HISTOGRAM_HPP
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "stopwatch.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief The percentiles of a distribution of latencies, in nanoseconds
+struct LatencyPercentiles {
+    std::int64_t p50 = 0;
+    std::int64_t p90 = 0;
+    std::int64_t p99 = 0;
+    std::int64_t p999 = 0;
+    std::int64_t max = 0;
+
+    friend std::ostream& operator<<(std::ostream& os, LatencyPercentiles const& p) {
+        return os << "{p50:" << p.p50 << " ns, p90:" << p.p90 << " ns, p99:" << p.p99 << " ns, p99.9:" << p.p999 << " ns, max:" << p.max << " ns}";
+    }
+};
+
+//! \brief A histogram of durations in nanoseconds, from one nanosecond to a highest trackable value, with a given number of significant digits
+//! \details Values are grouped in buckets covering powers of two, each divided into linear sub-buckets, in the manner of
+//! HdrHistogram: the value reported for a bucket is within a relative error of 10^-digits from any value recorded in it, and the
+//! memory taken grows with the logarithm of the range only. Recording computes the index with a count of leading zeros, in
+//! constant time. The histogram is not thread-safe: each thread records into its own, and histograms with the same configuration
+//! are merged by adding their counts. Values above the highest trackable one are counted in the last bucket, while the
+//! maximum is kept exact. Negative values are recorded as zero, including in the minimum and maximum.
+class LatencyHistogram {
+  public:
+    //! \brief Construct for values up to \a highest_trackable_value nanoseconds, one hour by default, with \a significant_digits from 1 to 5
+    LatencyHistogram(std::int64_t highest_trackable_value = 3600'000'000'000, unsigned int significant_digits = 3);
+
+    //! \brief Record a duration of \a nanoseconds, negative ones being recorded as zero
+    void record(std::int64_t nanoseconds) {
+        std::int64_t exact = nanoseconds < 0 ? 0 : nanoseconds;
+        std::int64_t value = exact > _highest_trackable_value ? _highest_trackable_value : exact;
+        ++_counts[_index(static_cast<std::uint64_t>(value))];
+        ++_total_count;
+        if (exact > _max) _max = exact;
+        if (exact < _min) _min = exact;
+    }
+    //! \brief Record a duration
+    template<class R, class P> void record(std::chrono::duration<R,P> const& duration) {
+        record(static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+    //! \brief Record the duration measured by a stopwatch, between its restart and its last click
+    template<class D, class C> void record(Stopwatch<D,C> const& sw) { record(sw.duration()); }
+
+    //! \brief Add the counts of \a other, which must have the same configuration
+    LatencyHistogram& operator+=(LatencyHistogram const& other);
+    //! \brief Remove all the values recorded
+    void reset();
+
+    //! \brief The number of values recorded
+    std::uint64_t total_count() const { return _total_count; }
+    //! \brief The smallest value recorded, or zero if none
+    std::int64_t min() const { return _total_count == 0 ? 0 : _min; }
+    //! \brief The largest value recorded, or zero if none
+    std::int64_t max() const { return _total_count == 0 ? 0 : _max; }
+    //! \brief The mean of the values recorded, as represented by their buckets
+    double mean() const;
+    //! \brief The value below or at which \a percentile percent of the values recorded fall, up to the precision of the histogram
+    std::int64_t value_at_percentile(double percentile) const;
+    //! \brief The usual percentiles
+    LatencyPercentiles percentiles() const;
+
+    //! \brief The number of counters, which determines the memory taken
+    size_t number_of_counters() const { return _counts.size(); }
+
+  private:
+    size_t _index(std::uint64_t value) const {
+        unsigned int bucket = static_cast<unsigned int>(64 - std::countl_zero(value | _sub_bucket_mask)) - (_sub_bucket_half_count_magnitude + 1);
+        std::uint64_t sub_bucket = value >> bucket;
+        return static_cast<size_t>(((std::uint64_t(bucket) + 1) << _sub_bucket_half_count_magnitude) + sub_bucket - _sub_bucket_half_count);
+    }
+    //! \brief The lowest value of the bucket at \a index
+    std::uint64_t _value_at(size_t index) const;
+    //! \brief The highest value equivalent to the lowest value of the bucket at \a index
+    std::uint64_t _highest_equivalent_at(size_t index) const;
+  private:
+    std::int64_t _highest_trackable_value;
+    unsigned int _significant_digits;
+    unsigned int _sub_bucket_half_count_magnitude;
+    std::uint64_t _sub_bucket_half_count;
+    std::uint64_t _sub_bucket_mask;
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _total_count;
+    std::int64_t _min;
+    std::int64_t _max;
+};
+
+} // namespace Helper
+
+#endif // HELPER_LATENCY_HISTOGRAM_HPP
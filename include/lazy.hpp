@@ -33,22 +33,209 @@
 #ifndef HELPER_LAZY_HPP
 #define HELPER_LAZY_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include "memory_budget.hpp"
+#include "thread_pool.hpp"
 
 namespace Helper {
 
 using std::function;
 using std::shared_ptr;
 
-template<class O>
+//! \brief An object of type \a O created on first access by calling a function of type \a F, which returns the object by value
+//! \details The function is stored by its concrete type and the object is constructed directly in inline storage from the
+//! returned value, hence creation allocates nothing and \a O needs be neither copyable nor movable. Access is thread-safe with
+//! the same guarantees as for the type-erased Lazy<O>; copies and moves, which copy or move the function and the object if created,
+//! must not race with the creation. Use make_lazy to deduce the types.
+template<class O, class F = void>
 class Lazy {
+    static constexpr std::uint8_t EMPTY = 0;
+    static constexpr std::uint8_t CREATING = 1;
+    static constexpr std::uint8_t CREATED = 2;
   public:
-    O const& operator()() const { if (_obj == nullptr) _obj.reset(_func()); return *_obj; };
-    Lazy(function<O*()> func) : _func(func) { }
+    O const& operator()() const {
+        if (_state.load(std::memory_order_acquire) != CREATED) _create();
+        return _object();
+    }
+    Lazy(F func) : _func(std::move(func)), _state(EMPTY) { }
+    Lazy(Lazy const& other) : _func(other._func), _state(EMPTY) {
+        if (other.is_created()) _emplace([&other]() -> O const& { return other._object(); });
+    }
+    Lazy(Lazy&& other) : _func(std::move(other._func)), _state(EMPTY) {
+        if (other.is_created()) _emplace([&other]() -> O&& { return std::move(other._object()); });
+    }
+    Lazy& operator=(Lazy const&) = delete;
+    ~Lazy() {
+        if (_state.load(std::memory_order_relaxed) == CREATED) _object().~O();
+    }
+    //! \brief Whether the object has already been created
+    bool is_created() const { return _state.load(std::memory_order_acquire) == CREATED; }
+  private:
+    O& _object() const { return *std::launder(reinterpret_cast<O*>(_storage)); }
+
+    //! \brief Construct the object from the result of \a g and mark it as created
+    template<class G> void _emplace(G&& g) const {
+        ::new (static_cast<void*>(_storage)) O(g());
+        _state.store(CREATED, std::memory_order_release);
+    }
+
+    void _create() const {
+        std::uint8_t state = _state.load(std::memory_order_acquire);
+        while (state != CREATED) {
+            if (state == EMPTY) {
+                if (not _state.compare_exchange_weak(state, CREATING, std::memory_order_acquire)) continue;
+                try {
+                    _emplace(_func);
+                } catch (...) {
+                    _state.store(EMPTY, std::memory_order_release);
+                    _notify();
+                    throw;
+                }
+                _notify();
+                return;
+            }
+#if defined(__cpp_lib_atomic_wait)
+            _state.wait(CREATING, std::memory_order_acquire);
+#else
+            std::this_thread::yield();
+#endif
+            state = _state.load(std::memory_order_acquire);
+        }
+    }
+
+    void _notify() const {
+#if defined(__cpp_lib_atomic_wait)
+        _state.notify_all();
+#endif
+    }
+  private:
+    [[no_unique_address]] mutable F _func;
+    mutable std::atomic<std::uint8_t> _state;
+    alignas(O) mutable unsigned char _storage[sizeof(O)];
+};
+
+//! \brief A lazy object created by \a func, stored inline along with the function
+template<class F> Lazy<std::invoke_result_t<F&>,F> make_lazy(F func) {
+    return Lazy<std::invoke_result_t<F&>,F>(std::move(func));
+}
+
+//! \brief An object of type \a O created by a function on first access, where the function is type-erased
+//! \details Access is thread-safe and the function is run exactly once, by the first caller, while concurrent callers wait for it:
+//! if the function throws, the exception propagates and the next access retries. Once created, access takes a single acquire load.
+//! Copies share the same object, hence the function is run once across all copies. Being independent of the type of
+//! the function, lazy objects of the same type \a O can be held in the same container. The object can also be created ahead of
+//! its first access on a thread pool, using prefetch.
+template<class O>
+class Lazy<O,void> {
+    struct State {
+        State(function<O*()> f) : func(std::move(f)), ptr(nullptr) { }
+        //! \brief Create the object unless already created, waiting for a creation in progress
+        O const* create() {
+            O const* result = ptr.load(std::memory_order_acquire);
+            if (result == nullptr) {
+                std::lock_guard<std::mutex> lock(mutex);
+                result = ptr.load(std::memory_order_relaxed);
+                if (result == nullptr) {
+                    obj.reset(func());
+                    func = nullptr;
+                    result = obj.get();
+                    ptr.store(result,std::memory_order_release);
+                }
+            }
+            return result;
+        }
+        function<O*()> func;
+        std::atomic<O const*> ptr;
+        std::mutex mutex;
+        std::unique_ptr<O const> obj;
+    };
+  public:
+    O const& operator()() const {
+        O const* ptr = _ptr.load(std::memory_order_acquire);
+        if (ptr != nullptr) return *ptr;
+        ptr = _state->create();
+        _ptr.store(ptr,std::memory_order_release);
+        return *ptr;
+    };
+    Lazy(function<O*()> func) : _state(std::make_shared<State>(std::move(func))), _ptr(nullptr) { }
+    Lazy(Lazy const& other) : _state(other._state), _ptr(other._ptr.load(std::memory_order_acquire)) { }
+    Lazy& operator=(Lazy const& other) {
+        _state = other._state;
+        _ptr.store(other._ptr.load(std::memory_order_acquire),std::memory_order_release);
+        return *this;
+    }
+    //! \brief Whether the object has already been created
+    bool is_created() const { return _state->ptr.load(std::memory_order_acquire) != nullptr; }
+    //! \brief Start creating the object on a worker of \a pool, unless already created
+    //! \details A later access waits for the creation if in progress, or creates the object itself if the task has not started yet.
+    //! The task holds the object weakly until it starts, so that if all the copies of this lazy object are destroyed before then,
+    //! nothing is created; if the function throws, the exception is discarded and the next access retries.
+    void prefetch(ThreadPool& pool = ThreadPool::global()) const {
+        if (is_created()) return;
+        pool.enqueue([state = std::weak_ptr<State>(_state)]{
+            if (auto locked = state.lock()) locked->create();
+        });
+    }
+  private:
+    shared_ptr<State> _state;
+    mutable std::atomic<O const*> _ptr;
+};
+
+//! \brief An object of type \a O created by a function on access, which can be dropped under memory pressure and recreated later
+//! \details The object is charged to a MemoryBudget with the size given by a function of the object, by default the size of \a O.
+//! When the budget is exceeded, the least recently accessed objects are dropped and created again on their next access, hence
+//! the function is kept and may run several times. Access returns a shared pointer, which keeps the object alive while in use
+//! even if it is dropped meanwhile. Access is thread-safe; copies share the same object.
+template<class O>
+class EvictableLazy {
+    struct State : public MemoryBudget::Entry {
+        State(function<O*()> f, function<size_t(O const&)> s, MemoryBudget& budget)
+            : MemoryBudget::Entry(budget), func(std::move(f)), size(std::move(s)) { }
+        shared_ptr<O const> get() {
+            shared_ptr<O const> result;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (obj == nullptr) {
+                    shared_ptr<O const> created(func());
+                    _charge(size(*created));
+                    obj = std::move(created);
+                } else {
+                    _touch();
+                }
+                result = obj;
+            }
+            _trim_budget();
+            return result;
+        }
+        bool created() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return obj != nullptr;
+        }
+        std::shared_ptr<void const> _release() override {
+            return std::move(obj);
+        }
+        function<O*()> func;
+        function<size_t(O const&)> size;
+        shared_ptr<O const> obj;
+    };
+  public:
+    EvictableLazy(function<O*()> func, function<size_t(O const&)> size = [](O const&) { return sizeof(O); },
+                  MemoryBudget& budget = MemoryBudget::global())
+        : _state(std::make_shared<State>(std::move(func), std::move(size), budget)) { }
+
+    //! \brief The object, created if not held
+    shared_ptr<O const> operator()() const { return _state->get(); }
+    //! \brief Whether the object is currently held
+    bool is_created() const { return _state->created(); }
   private:
-    function<O*()> _func;
-    mutable shared_ptr<O> _obj;
+    shared_ptr<State> _state;
 };
 
 } // namespace Helper
@@ -33,66 +33,325 @@
 #ifndef HELPER_LRU_CACHE_HPP
 #define HELPER_LRU_CACHE_HPP
 
-#include <map>
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <iterator>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <span>
+#include <vector>
 #include "macros.hpp"
+#include "access_trace.hpp"
+#include "metaprogramming.hpp"
+#include "snapshot.hpp"
+#include "timer_wheel.hpp"
+#include "cache_statistics.hpp"
 
 namespace Helper {
 
 using std::size_t;
 
+//! \brief The Least Recently Used eviction policy, with no bookkeeping of its own
+//! \details An eviction policy is notified of hits, misses, insertions, evictions and erasures of labels, and chooses
+//! the victim when the cache is full given the candidate label to insert and the least recently used label. See eviction_policy.hpp
+//! for scan-resistant alternatives.
+template<class L, class H = std::hash<L>> class LRUEviction {
+  public:
+    LRUEviction(size_t) { }
+    void on_hit(L const&) { }
+    void on_miss(L const&) { }
+    L const& victim(L const&, L const& least_recently_used) const { return least_recently_used; }
+    void on_insert(L const&) { }
+    void on_evict(L const&) { }
+    void on_erase(L const&) { }
+};
+
+//! \brief Whether the hash function \a H also accepts keys of type \a K, having declared itself transparent
+template<class H, class K> concept TransparentHashFor = requires(H const& h, K const& k) {
+    typename H::is_transparent;
+    { h(k) } -> ConvertibleTo<size_t>;
+};
+
+//! \brief Whether a cache with labels \a L hashed by \a H can be searched by a key of type \a K
+//! \details Either \a K is hashed directly by a transparent \a H, or it is converted to a label
+template<class K, class L, class H> concept LabelLookupKey = SameAs<K,L> or TransparentHashFor<H,K> or ConvertibleTo<K const&,L>;
+
+//! \brief The outcome of looking up a batch of labels
+//! \details \a values has one entry per label in the batch, empty for a miss, and \a misses has the indices of the missed labels in increasing order
+template<class R> struct BatchLookup {
+    std::vector<R> values;
+    std::vector<size_t> misses;
+};
+
 //! \brief A Least Recently Used cache for holding a limited number of commonly-accessed objects of type \a V indexed by a label \a L
-template<class L, class V> class LRUCache {
+//! \details Elements are indexed by a hash table on the label and ordered by a recency list, so that lookup,
+//! promotion and eviction take amortized constant time. The label type must be hashable by \a H.
+//! Besides the number of elements, the cache can be bounded by a total weight, where each element carries a
+//! weight either given explicitly on insertion or computed by a weigher: eviction then proceeds until both bounds are satisfied.
+//! The element to evict is chosen by the eviction policy \a P, which defaults to the least recently used one.
+//! Elements may be given a time to live on insertion: an expired element is removed when accessed, and all expired
+//! elements are removed in bulk on insertion through a timer wheel, so that expiry also takes constant time per element.
+//! Hits, misses, insertions, evictions and expirations are counted, unless HELPER_DISABLE_CACHE_STATISTICS is defined:
+//! a lookup through has_label that fails counts as a miss, while one that succeeds is expected to be followed by get.
+template<class L, class V, class P = LRUEviction<L>, class H = std::hash<L>> class LRUCache {
+  public:
+    using ClockType = std::chrono::steady_clock;
+    using TimePointType = ClockType::time_point;
+    using DurationType = ClockType::duration;
   private:
-    struct AgeValuePair {
-        AgeValuePair(size_t a, V v) : age(a), value(v) { }
-        size_t age;
+    using RecencyList = std::list<L const*>;
+    struct Entry {
+        template<class... AS> Entry(TimePointType d, CacheCounters::Stamp s, AS&&... args) : weight(0), deadline(d), stamp(s), value(std::forward<AS>(args)...) { }
+        typename RecencyList::iterator position;
+        size_t weight;
+        TimePointType deadline;
+        [[no_unique_address]] CacheCounters::Stamp stamp;
         V value;
     };
+    using KeyEqualType = std::conditional_t<TransparentHashFor<H,L>,std::equal_to<>,std::equal_to<L>>;
+    using ElementMap = std::unordered_map<L,Entry,H,KeyEqualType>;
+    static constexpr TimePointType NO_DEADLINE = TimePointType::max();
   public:
+    //! \brief The function giving the weight of an element, for example its size in bytes
+    using WeigherType = std::function<size_t(L const&, V const&)>;
+
     //! \brief Construct with a given \a maximum_size
-    LRUCache(size_t maximum_size) : _maximum_size(maximum_size) { HELPER_PRECONDITION(maximum_size>0); }
+    //! \details Each element has unit weight and the total weight is unbounded
+    LRUCache(size_t maximum_size)
+        : LRUCache(maximum_size, std::numeric_limits<size_t>::max(), [](L const&, V const&){ return size_t(1); }) { }
 
-    //! \brief Check whether the label is present
-    bool has_label(L const& label) { return (_elements.find(label) != _elements.end()); }
+    //! \brief Construct with a given \a maximum_size and \a maximum_weight, where the weight of an element is given by \a weigher
+    //! \details To bound the cache by weight only, use the maximum \c size_t value as \a maximum_size
+    LRUCache(size_t maximum_size, size_t maximum_weight, WeigherType const& weigher)
+        : _maximum_size(maximum_size), _maximum_weight(maximum_weight), _current_weight(0), _weigher(weigher), _policy(maximum_size), _trace(nullptr) {
+        HELPER_PRECONDITION(maximum_size>0);
+        HELPER_PRECONDITION(maximum_weight>0);
+    }
+
+    //! \brief Check whether the label is present and not expired
+    //! \details As for all lookups, \a label can be of any type hashed by a transparent hash function, such as \c std::string_view
+    //! for \c String labels, in which case no label is constructed
+    template<LabelLookupKey<L,H> K = L> bool has_label(K const& label) const {
+        auto e = _lookup(label);
+        bool result = (e != _elements.end() and not _is_expired(e->second));
+        if (not result) {
+            _counters.miss();
+            _record(label);
+        }
+        return result;
+    }
 
     //! \brief Get the element identified with \a label
-    //! \details Updates age accordingly
-    V const& get(L const& label) {
-        auto e = _elements.find(label);
+    //! \details Promotes the element to the most recently used one
+    template<LabelLookupKey<L,H> K = L> V const& get(K const& label) {
+        CacheCounters::LatencySample sample(_counters);
+        _record(label);
+        auto e = _find(label);
+        if (e == _elements.end()) _counters.miss();
         HELPER_ASSERT_MSG(e != _elements.end(), "Cache has no element for label " << label);
-        for (auto& other : _elements) {
-            if (other.second.age < e->second.age)
-                other.second.age++;
-        }
-        e->second.age = 0;
+        _promote(e);
         return e->second.value;
     }
 
+    //! \brief Get a pointer to the element identified with \a label, or \c nullptr if not present
+    //! \details Promotes the element to the most recently used one; the pointer is valid until the element is removed
+    template<LabelLookupKey<L,H> K = L> V const* try_get(K const& label) {
+        CacheCounters::LatencySample sample(_counters);
+        _record(label);
+        auto e = _find(label);
+        if (e == _elements.end()) {
+            _counters.miss();
+            return nullptr;
+        }
+        _promote(e);
+        return &e->second.value;
+    }
+
     //! \brief The age of a given \a label in the cache
-    size_t age(L const& label) {
-        auto e = _elements.find(label);
-        HELPER_ASSERT_MSG(e != _elements.end(), "Cache has no element for label " << label);
-        return e->second.age;
-    }
-
-    //! \brief Insert the element
-    //! \details The element must not already exist; updates ages accordingly
-    void put(L const& label, V const& val) {
-        HELPER_PRECONDITION(not has_label(label));
-        if (_elements.size() < _maximum_size) {
-            for (auto& other : _elements) other.second.age++;
-        } else {
-            auto to_remove = _elements.end();
-            for (auto it = _elements.begin(); it != _elements.end(); ++it) {
-                if (it->second.age == _maximum_size-1) to_remove = it;
-                it->second.age++;
+    //! \details Zero for the most recently used element; takes time linear in the age, hence it is meant for inspection only
+    template<LabelLookupKey<L,H> K = L> size_t age(K const& label) const {
+        auto e = _lookup(label);
+        HELPER_ASSERT_MSG(e != _elements.end() and not _is_expired(e->second), "Cache has no element for label " << label);
+        return static_cast<size_t>(std::distance(_recency.begin(), typename RecencyList::const_iterator(e->second.position)));
+    }
+
+    //! \brief Get pointers to the elements identified with \a labels, promoting those present in order
+    //! \details The clock is read once for the whole batch, and hits and misses are counted once.
+    //! The pointers are valid until the elements are removed.
+    BatchLookup<V const*> get_many(std::span<L const> labels) {
+        auto now = ClockType::now();
+        if (_trace != nullptr) for (auto const& label : labels) _record(label);
+        BatchLookup<V const*> result;
+        result.values.reserve(labels.size());
+        for (size_t i=0; i<labels.size(); ++i) {
+            auto e = _elements.find(labels[i]);
+            if (e != _elements.end() and e->second.deadline <= now) {
+                _expire(e);
+                e = _elements.end();
             }
-            _elements.erase(to_remove);
+            if (e == _elements.end()) {
+                result.values.push_back(nullptr);
+                result.misses.push_back(i);
+            } else {
+                _touch(e);
+                result.values.push_back(&e->second.value);
+            }
+        }
+        _counters.hit(labels.size()-result.misses.size());
+        _counters.miss(result.misses.size());
+        return result;
+    }
+
+    //! \brief Get the element identified with \a label, inserting the result of \a factory if not present
+    //! \details The factory takes no arguments and returns a value convertible to \a V, which is moved into the cache;
+    //! a label is constructed from \a label only on a miss
+    template<LabelLookupKey<L,H> K = L, class F> requires ConstructibleFrom<L,K const&> V const& get_or_compute(K const& label, F const& factory) {
+        CacheCounters::LatencySample sample(_counters);
+        _record(label);
+        auto e = _find(label);
+        if (e == _elements.end()) {
+            _counters.miss();
+            return _insert(L(label),std::nullopt,NO_DEADLINE,factory());
         }
-        _elements.insert({label,AgeValuePair(0,val)});
+        _promote(e);
+        return e->second.value;
+    }
+
+    //! \brief Insert the element, with weight given by the weigher
+    //! \details The element must not already exist; evicts elements until the cache has room for it.
+    //! An rvalue \a val is moved into the cache rather than copied
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val) {
+        _insert(label,std::nullopt,NO_DEADLINE,std::forward<VV>(val));
+    }
+
+    //! \brief Insert the element with an explicit \a weight
+    //! \details The element must not already exist and its weight must not exceed the maximum weight;
+    //! evicts elements until the cache has room for it
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val, size_t weight) {
+        _insert(label,weight,NO_DEADLINE,std::forward<VV>(val));
+    }
+
+    //! \brief Insert the element with weight given by the weigher, expiring after \a time_to_live
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val, DurationType time_to_live) {
+        _insert(label,std::nullopt,ClockType::now()+time_to_live,std::forward<VV>(val));
+    }
+
+    //! \brief Insert the element with an explicit \a weight, expiring after \a time_to_live
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val, size_t weight, DurationType time_to_live) {
+        _insert(label,weight,ClockType::now()+time_to_live,std::forward<VV>(val));
+    }
+
+    //! \brief Insert the elements with \a labels and respective \a values, with weights given by the weigher
+    //! \details Same as putting each element in order, hence the elements must not already exist and later elements may evict earlier ones
+    void put_many(std::span<L const> labels, std::span<V const> values) {
+        HELPER_PRECONDITION(labels.size() == values.size());
+        expire();
+        _elements.reserve(std::min(_elements.size()+labels.size(),_maximum_size));
+        for (size_t i=0; i<labels.size(); ++i) _insert(labels[i],std::nullopt,NO_DEADLINE,values[i]);
+    }
+
+    //! \brief Insert the element constructed in place from \a args, with weight given by the weigher
+    //! \details The element must not already exist; the value is constructed exactly once, hence \a V needs be neither copyable nor movable
+    template<class... AS> V const& emplace(L const& label, AS&&... args) {
+        return _insert(label,std::nullopt,NO_DEADLINE,std::forward<AS>(args)...);
+    }
+
+    //! \brief Remove the element identified with \a label, if present
+    //! \return Whether an element was removed
+    template<LabelLookupKey<L,H> K = L> bool erase(K const& label) {
+        auto e = _lookup(label);
+        if (e == _elements.end()) return false;
+        _erase(e);
+        return true;
+    }
+
+    //! \brief Remove all the elements
+    void clear() {
+        while (not _elements.empty()) _erase(_elements.begin());
+    }
+
+    //! \brief Save the elements not expired to a snapshot file at \a path, along with their weights and expiry times
+    //! \details Expiry times are saved as wall-clock times, so that the time elapsed until the snapshot is loaded, possibly by
+    //! another process, counts against the time to live of the elements.
+    //! Labels and values are serialized by \a label_serializer and \a value_serializer, as described for TrivialSerializer;
+    //! \a version identifies their serialization format. Elements are saved from the least to the most recently used.
+    //! \return Whether the file was written successfully
+    template<class LS, class VS> bool save(std::string const& path, LS const& label_serializer, VS const& value_serializer, std::uint32_t version = 0) const {
+        SnapshotWriter writer(version);
+        auto now = ClockType::now();
+        auto wall_now = std::chrono::system_clock::now();
+        for (auto it = _recency.rbegin(); it != _recency.rend(); ++it) {
+            auto const& entry = _elements.find(**it)->second;
+            if (_is_expired(entry)) continue;
+            std::int64_t expiry = -1;
+            if (entry.deadline != NO_DEADLINE)
+                expiry = std::chrono::duration_cast<std::chrono::nanoseconds>((wall_now+(entry.deadline-now)).time_since_epoch()).count();
+            writer.begin_record(entry.weight, expiry);
+            label_serializer.serialize(**it, writer.buffer());
+            writer.end_field();
+            value_serializer.serialize(entry.value, writer.buffer());
+            writer.end_field();
+        }
+        return writer.write(path);
+    }
+
+    //! \brief Replace the elements with those of the snapshot file at \a path, restoring their recency order
+    //! \details The file is memory-mapped and each value is deserialized directly into the cache. Elements already expired by the
+    //! wall clock and elements heavier than the maximum weight are skipped, and if the snapshot holds more elements than fit, the
+    //! least recently used ones are evicted.
+    //! \return Whether the snapshot was loaded; if the file is missing, corrupt or has a different \a version, or deserialization
+    //! throws, the cache is left empty
+    template<class LS, class VS> bool load(std::string const& path, LS const& label_serializer, VS const& value_serializer, std::uint32_t version = 0) {
+        clear();
+        SnapshotReader reader(path, version);
+        if (not reader.is_valid()) return false;
+        auto now = ClockType::now();
+        auto wall_now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        try {
+            for (auto const& record : reader.records()) {
+                if (record.weight > _maximum_weight) continue;
+                if (record.expiry >= 0 and record.expiry <= wall_now) continue;
+                auto deadline = record.expiry < 0 ? NO_DEADLINE : now + std::chrono::duration_cast<DurationType>(std::chrono::nanoseconds(record.expiry-wall_now));
+                _insert(label_serializer.deserialize(record.label), static_cast<size_t>(record.weight), deadline, value_serializer.deserialize(record.value));
+            }
+        } catch (...) {
+            clear();
+            return false;
+        }
+        return true;
+    }
+
+    //! \brief Remove all the expired elements
+    void expire() {
+        if (_timers == nullptr or _timers->empty()) return;
+        _timers->advance(ClockType::now(),[this](L const* label){ _expire(_elements.find(*label)); });
+    }
+
+    //! \brief A snapshot of the counters
+    CacheStatistics statistics() const {
+        return _counters.statistics();
+    }
+
+    //! \brief Sample the latency of one lookup every \a period ones, or none if \a period is zero
+    void set_latency_sampling_period(size_t period) {
+        _counters.set_latency_sampling_period(period);
+    }
+
+    //! \brief Record the labels looked up by get, try_get, get_or_compute and get_many into \a trace, or stop recording if \c nullptr
+    //! \details As for the statistics, a lookup through has_label is recorded if it fails, while one that succeeds is expected to
+    //! be followed by get. The trace is not owned and must outlive the recording; see MissRatioCurve for its analysis
+    void set_access_trace(AccessTraceWriter* trace) {
+        _trace = trace;
     }
 
     //! \brief The current size due to putting elements
+    //! \details Includes expired elements not yet removed
     size_t current_size() const {
         return _elements.size();
     }
@@ -102,9 +361,132 @@ template<class L, class V> class LRUCache {
         return _maximum_size;
     }
 
+    //! \brief The current total weight of the elements
+    size_t current_weight() const {
+        return _current_weight;
+    }
+
+    //! \brief The maximum total weight as initially supplied
+    size_t maximum_weight() const {
+        return _maximum_weight;
+    }
+
+    //! \brief The eviction policy
+    P const& policy() const {
+        return _policy;
+    }
+
+  private:
+    bool _is_expired(Entry const& entry) const {
+        return entry.deadline != NO_DEADLINE and entry.deadline <= ClockType::now();
+    }
+
+    //! \brief Find the element identified with \a label, removing it if expired
+    template<class K> typename ElementMap::iterator _find(K const& label) {
+        auto e = _lookup(label);
+        if (e != _elements.end() and _is_expired(e->second)) {
+            _expire(e);
+            return _elements.end();
+        }
+        return e;
+    }
+
+    //! \brief Construct the value in place, then make room for it
+    //! \details The weight is computed after construction when not given, so that the weigher can inspect the value;
+    //! the new element is not in the recency list while evicting, hence it cannot be chosen as victim
+    template<class... AS> V const& _insert(L const& label, std::optional<size_t> weight, TimePointType deadline, AS&&... args) {
+        expire();
+        HELPER_PRECONDITION(_find(label) == _elements.end());
+        auto e = _elements.emplace(std::piecewise_construct, std::forward_as_tuple(label),
+                                   std::forward_as_tuple(deadline, _counters.stamp(), std::forward<AS>(args)...)).first;
+        // Until linked into the recency list, the element must be erased if anything fails
+        size_t w = 0;
+        try {
+            w = weight.has_value() ? weight.value() : _weigher(e->first,e->second.value);
+            HELPER_PRECONDITION_MSG(w <= _maximum_weight, "Weight " << w << " of label " << label << " exceeds the maximum weight " << _maximum_weight);
+            _policy.on_miss(label);
+            while (_elements.size() > _maximum_size or _current_weight > _maximum_weight - w) _evict(label);
+        } catch (...) {
+            _elements.erase(e);
+            throw;
+        }
+        _counters.insertion();
+        _recency.push_front(&e->first);
+        e->second.position = _recency.begin();
+        e->second.weight = w;
+        _current_weight += w;
+        if (deadline != NO_DEADLINE) {
+            if (_timers == nullptr) _timers = std::make_unique<TimerWheel<L const*>>(std::chrono::milliseconds(1));
+            _timers->schedule(&e->first,deadline);
+        }
+        _policy.on_insert(label);
+        return e->second.value;
+    }
+
+    //! \brief The key to search the element map with, which is \a label itself unless it needs be converted to a label
+    template<class K> static decltype(auto) _key(K const& label) {
+        if constexpr (SameAs<K,L>) return (label);
+#if defined(__cpp_lib_generic_unordered_lookup)
+        else if constexpr (TransparentHashFor<H,K>) return (label);
+#endif
+        else return L(label);
+    }
+
+    template<class K> typename ElementMap::iterator _lookup(K const& label) { return _elements.find(_key(label)); }
+    template<class K> typename ElementMap::const_iterator _lookup(K const& label) const { return _elements.find(_key(label)); }
+
+    template<class K> void _record(K const& label) const {
+        if (_trace != nullptr) _trace->record(static_cast<std::uint64_t>(H()(_key(label))));
+    }
+
+    void _promote(typename ElementMap::iterator e) {
+        _counters.hit();
+        _touch(e);
+    }
+
+    //! \brief Make the element the most recently used one, without counting a hit
+    void _touch(typename ElementMap::iterator e) {
+        _recency.splice(_recency.begin(), _recency, e->second.position);
+        _policy.on_hit(e->first);
+    }
+
+    //! \brief Evict the element chosen by the policy to make room for \a candidate
+    void _evict(L const& candidate) {
+        auto e = _elements.find(_policy.victim(candidate, *_recency.back()));
+        _policy.on_evict(e->first);
+        _counters.eviction(e->second.stamp);
+        _remove(e);
+    }
+
+    void _expire(typename ElementMap::iterator e) {
+        _counters.expiration();
+        _erase(e);
+    }
+
+    //! \brief Remove an element on request or on expiry
+    void _erase(typename ElementMap::iterator e) {
+        _policy.on_erase(e->first);
+        _remove(e);
+    }
+
+    void _remove(typename ElementMap::iterator e) {
+        if (e->second.deadline != NO_DEADLINE) _timers->cancel(&e->first);
+        _current_weight -= e->second.weight;
+        _recency.erase(e->second.position);
+        _elements.erase(e);
+    }
+
   private:
     size_t _maximum_size;
-    std::map<L,AgeValuePair> _elements;
+    size_t _maximum_weight;
+    size_t _current_weight;
+    WeigherType _weigher;
+    P _policy;
+    RecencyList _recency;
+    ElementMap _elements;
+    std::unique_ptr<TimerWheel<L const*>> _timers;
+    mutable CacheCounters _counters;
+    AccessTraceWriter* _trace;
 };
 
 
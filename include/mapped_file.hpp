@@ -0,0 +1,75 @@
+/***************************************************************************
+ *            mapped_file.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file mapped_file.hpp
+ *  \brief A read-only memory mapping of a whole file
+ */
+
+#ifndef HELPER_MAPPED_FILE_HPP
+#define HELPER_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A read-only view of the contents of a file, mapped into memory
+//! \details Pages are loaded lazily by the operating system on first access, hence opening is cheap regardless of the file size.
+//! A file that does not exist, cannot be mapped or is empty yields a closed mapping, with no data.
+class MappedFile {
+  public:
+    //! \brief Map the file at \a path
+    MappedFile(std::string const& path);
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    //! \brief Whether the file has been mapped
+    bool is_open() const { return _data != nullptr; }
+    //! \brief The first byte of the file, or \c nullptr if not open
+    char const* data() const { return _data; }
+    //! \brief The size of the file in bytes, or zero if not open
+    size_t size() const { return _size; }
+
+  private:
+    void _unmap();
+  private:
+    char const* _data;
+    size_t _size;
+#ifdef _WIN32
+    void* _mapping;
+#endif
+};
+
+} // namespace Helper
+
+#endif // HELPER_MAPPED_FILE_HPP
@@ -0,0 +1,151 @@
+/***************************************************************************
+ *            memo.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file memo.hpp
+ *  \brief Lazily computed values that track the values they read, for incremental recomputation
+ */
+
+#ifndef HELPER_MEMO_HPP
+#define HELPER_MEMO_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A node of a graph of memoized values, where an edge goes from a value to each value whose computation read it
+//! \details Reading a node while another node is being computed on the same thread records the edge. Invalidating a node marks
+//! dirty all the nodes that transitively depend on it, and only those, so that they are recomputed on their next read; since a
+//! clean node only depends on clean nodes, marking stops at nodes already dirty. Dependencies are recorded anew at each computation,
+//! hence they can change with the values read. Nodes keep their dependencies alive, and refer to their dependents weakly.
+//! The graph is not thread-safe.
+class MemoNode : public std::enable_shared_from_this<MemoNode> {
+  public:
+    MemoNode(bool dirty) : _dirty(dirty), _computing(false) { }
+    MemoNode(MemoNode const&) = delete;
+    MemoNode& operator=(MemoNode const&) = delete;
+    virtual ~MemoNode() = default;
+
+    //! \brief Whether the node needs to be computed before its next read
+    bool is_dirty() const { return _dirty; }
+    //! \brief The number of nodes whose last computation read this node and that still exist
+    size_t number_of_dependents() const;
+    //! \brief Mark dirty all the nodes depending on this node, transitively
+    void invalidate_dependents();
+    //! \brief Record that the node being computed on this thread, if any, depends on this node
+    void record_read();
+
+  protected:
+    //! \brief The scope of a computation of a node, during which reads are recorded as its dependencies
+    //! \details On entry the previous dependencies are dropped; on successful exit the node is marked clean
+    class ComputationScope {
+      public:
+        ComputationScope(MemoNode& node);
+        ~ComputationScope();
+        void complete();
+      private:
+        MemoNode& _node;
+    };
+
+  protected:
+    bool _dirty;
+  private:
+    bool _computing;
+    std::vector<std::shared_ptr<MemoNode>> _dependencies;
+    std::vector<std::weak_ptr<MemoNode>> _dependents;
+};
+
+//! \brief A value of type \a O read by memoized computations, which are invalidated when the value is set
+template<class O> class MemoInput {
+    struct Node : public MemoNode {
+        Node(O v) : MemoNode(false), value(std::move(v)) { }
+        O value;
+    };
+  public:
+    MemoInput(O value) : _node(std::make_shared<Node>(std::move(value))) { }
+
+    //! \brief Read the value, recording the dependency of the computation in progress
+    O const& operator()() const {
+        _node->record_read();
+        return _node->value;
+    }
+
+    //! \brief Set the value, marking dirty the computations depending on it
+    void set(O value) {
+        _node->value = std::move(value);
+        _node->invalidate_dependents();
+    }
+
+    //! \brief The number of computations whose last run read this value
+    size_t number_of_dependents() const { return _node->number_of_dependents(); }
+
+  private:
+    std::shared_ptr<Node> _node;
+};
+
+//! \brief A value of type \a O computed by a function on first read and recomputed on the next read after a value it read changes
+//! \details Like Lazy<O>, the function returns the object by value; unlike it, the object is recomputed when dirty, which happens
+//! when a MemoInput or Memo read by the last computation is set or invalidated. Copies share the same node.
+template<class O> class Memo {
+    struct Node : public MemoNode {
+        Node(std::function<O()> f) : MemoNode(true), func(std::move(f)) { }
+        O const& get() {
+            record_read();
+            if (_dirty) {
+                ComputationScope scope(*this);
+                value.reset();
+                value.emplace(func());
+                scope.complete();
+            }
+            return *value;
+        }
+        std::function<O()> func;
+        std::optional<O> value;
+    };
+  public:
+    Memo(std::function<O()> func) : _node(std::make_shared<Node>(std::move(func))) { }
+
+    //! \brief Read the value, computing it if dirty and recording the dependency of the computation in progress
+    O const& operator()() const { return _node->get(); }
+
+    //! \brief Whether the value will be recomputed on the next read
+    bool is_dirty() const { return _node->is_dirty(); }
+    //! \brief The number of computations whose last run read this value
+    size_t number_of_dependents() const { return _node->number_of_dependents(); }
+
+  private:
+    std::shared_ptr<Node> _node;
+};
+
+} // namespace Helper
+
+#endif // HELPER_MEMO_HPP
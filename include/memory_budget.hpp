@@ -0,0 +1,115 @@
+/***************************************************************************
+ *            memory_budget.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file memory_budget.hpp
+ *  \brief A bound on the memory held by recomputable objects, enforced by evicting the least recently used ones
+ */
+
+#ifndef HELPER_MEMORY_BUDGET_HPP
+#define HELPER_MEMORY_BUDGET_HPP
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A budget of bytes shared by entries holding objects that can be dropped and recomputed
+//! \details Entries charge the budget when they create their object and are kept in order of last access. When the bytes charged
+//! exceed the capacity, the least recently used entries are asked to release their object, except for the most recent one, so
+//! that a single object larger than the capacity is still kept. Access to an entry that has been selected for eviction and not
+//! released yet cancels its eviction. The budget must outlive its entries.
+class MemoryBudget {
+  public:
+    //! \brief An entry holding an object under the budget
+    //! \details Derived classes hold their object under \a _mutex, during which they call _charge after creation and _touch on
+    //! access; after releasing the mutex they call _trim_budget, which may release other entries.
+    class Entry : public std::enable_shared_from_this<Entry> {
+      public:
+        Entry(MemoryBudget& budget) : _budget(budget), _listed(false), _bytes(0) { }
+        Entry(Entry const&) = delete;
+        Entry& operator=(Entry const&) = delete;
+        virtual ~Entry();
+      protected:
+        //! \brief Register the object just created, of size \a bytes, as the most recently used
+        void _charge(size_t bytes);
+        //! \brief Mark the object as the most recently used
+        void _touch();
+        //! \brief Release entries until the budget is respected
+        void _trim_budget() { _budget.trim(); }
+        //! \brief Drop the object, if any, called by the budget with \a _mutex held; return the object dropped, or null if none
+        //! \details The object is destroyed by the budget once all the locks are released, since its destructor may destroy other
+        //! entries of the same budget.
+        virtual std::shared_ptr<void const> _release() = 0;
+      protected:
+        std::mutex _mutex;
+      private:
+        friend class MemoryBudget;
+        MemoryBudget& _budget;
+        bool _listed;
+        size_t _bytes;
+        std::list<Entry*>::iterator _position;
+    };
+
+    //! \brief Construct with a capacity in bytes
+    MemoryBudget(size_t capacity);
+    MemoryBudget(MemoryBudget const&) = delete;
+    MemoryBudget& operator=(MemoryBudget const&) = delete;
+
+    //! \brief The budget shared by default, unbounded until a capacity is set
+    static MemoryBudget& global();
+
+    //! \brief The maximum number of bytes to hold
+    size_t capacity() const;
+    //! \brief Change the capacity, releasing entries if it is exceeded
+    void set_capacity(size_t capacity);
+    //! \brief The number of bytes held by the entries with an object
+    size_t used() const;
+    //! \brief The number of entries with an object
+    size_t number_of_entries() const;
+    //! \brief The number of objects released since construction
+    uint64_t number_of_evictions() const;
+
+    //! \brief Release the least recently used entries until the capacity is respected
+    void trim();
+
+  private:
+    mutable std::mutex _mutex;
+    size_t _capacity;
+    size_t _used;
+    uint64_t _evictions;
+    std::list<Entry*> _entries;
+};
+
+} // namespace Helper
+
+#endif // HELPER_MEMORY_BUDGET_HPP
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *            miss_ratio_curve.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file miss_ratio_curve.hpp
+ *  \brief Estimation of the miss ratio of an LRU cache as a function of its size, from a trace of accesses
+ */
+
+#ifndef HELPER_MISS_RATIO_CURVE_HPP
+#define HELPER_MISS_RATIO_CURVE_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief The miss ratio curve of an LRU cache over a trace of accesses, estimated in one pass by spatial sampling
+//! \details An access hits in an LRU cache of size \a c if and only if fewer than \a c distinct keys were accessed since the previous
+//! access to the same key, hence the histogram of these reuse distances gives the miss ratio for all sizes at once. Following SHARDS,
+//! only the keys whose hash falls below a threshold are tracked, a fraction \a sampling_rate of them: reuse distances among the
+//! sampled keys are scaled by the inverse of the rate, and the number of sampled accesses is corrected towards its expected value.
+//! Keys are expected to be uniformly distributed hashes, as recorded by AccessTraceWriter. Memory and time are proportional
+//! to the number of sampled accesses, with an additional logarithmic factor on time.
+class MissRatioCurve {
+  public:
+    //! \brief Estimate the curve for the accesses to \a keys, tracking a fraction \a sampling_rate of them
+    //! \details A \a sampling_rate of one computes the exact curve
+    MissRatioCurve(std::span<std::uint64_t const> keys, double sampling_rate = 0.01);
+
+    //! \brief The estimated fraction of accesses that miss in a cache of maximum size \a cache_size
+    double miss_ratio(size_t cache_size) const;
+
+    //! \brief The number of accesses in the trace
+    size_t number_of_accesses() const { return _number_of_accesses; }
+    //! \brief The number of accesses to sampled keys
+    size_t number_of_sampled_accesses() const { return _number_of_sampled_accesses; }
+    //! \brief The estimated number of distinct keys, which is the size beyond which only compulsory misses remain
+    size_t number_of_distinct_keys() const { return _number_of_distinct_keys; }
+    //! \brief The sampling rate
+    double sampling_rate() const { return _sampling_rate; }
+
+  private:
+    double _sampling_rate;
+    size_t _number_of_accesses;
+    size_t _number_of_sampled_accesses;
+    size_t _number_of_distinct_keys;
+    //! \brief The cumulative (corrected) number of sampled hits with reuse distance up to each index
+    std::vector<double> _cumulative_hits;
+    double _total;
+};
+
+} // namespace Helper
+
+#endif // HELPER_MISS_RATIO_CURVE_HPP
@@ -0,0 +1,110 @@
+/***************************************************************************
+ *            performance_counters.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file performance_counters.hpp
+ *  \brief Hardware and software event counters of the current thread, read like a stopwatch
+ */
+
+#ifndef HELPER_PERFORMANCE_COUNTERS_HPP
+#define HELPER_PERFORMANCE_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief The events that can be counted
+enum class PerformanceEvent : unsigned int {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    //! \brief The time spent running on a CPU, in nanoseconds
+    TASK_CLOCK,
+    PAGE_FAULTS,
+    CONTEXT_SWITCHES
+};
+
+//! \brief The number of kinds of PerformanceEvent
+constexpr size_t NUMBER_OF_PERFORMANCE_EVENTS = 7;
+
+//! \brief The name of \a event
+char const* name(PerformanceEvent event);
+
+//! \brief A group of counters of events of the current thread, measuring the counts between a restart and a click
+//! \details On Linux the counters are opened with \c perf_event_open, the hardware ones as a group counting in user space only,
+//! so that they are read together and scheduled on the processor together; counts are scaled when the kernel multiplexed them
+//! with others. Software events are counted in the kernel too when allowed, and \c CONTEXT_SWITCHES, which happen there
+//! only, is unavailable otherwise. Hardware events, which are often not exposed on virtual machines and containers, are
+//! optional: those that fail to open are unavailable, while the software events \c TASK_CLOCK, \c PAGE_FAULTS and
+//! \c CONTEXT_SWITCHES remain. On other systems, or if the system call is forbidden, no event is available and all counts
+//! are zero.
+class PerformanceCounters {
+  public:
+    //! \brief Open the counters of all the events, and restart
+    PerformanceCounters();
+    PerformanceCounters(PerformanceCounters const&) = delete;
+    PerformanceCounters& operator=(PerformanceCounters const&) = delete;
+    ~PerformanceCounters();
+
+    //! \brief Whether \a event is counted
+    bool is_available(PerformanceEvent event) const { return _slots[static_cast<size_t>(event)] >= 0; }
+    //! \brief Whether any hardware event is counted
+    bool has_hardware_events() const;
+
+    //! \brief The count of \a event between the last restart and the last click, or zero if not available
+    std::uint64_t count(PerformanceEvent event) const;
+
+    //! \brief Restart the counts from zero
+    PerformanceCounters& restart();
+    //! \brief Save the current counts
+    PerformanceCounters& click();
+
+    //! \brief Print the available counts
+    friend std::ostream& operator<<(std::ostream& os, PerformanceCounters const& counters);
+
+  private:
+    //! \brief The counter values in group order, scaled for multiplexing
+    std::vector<double> _read() const;
+  private:
+    //! \brief The position of each event in the group, or -1 if not available
+    std::array<int, NUMBER_OF_PERFORMANCE_EVENTS> _slots;
+    //! \brief The descriptors of the counters, starting with the group of hardware counters
+    std::vector<int> _descriptors;
+    size_t _group_size;
+    std::vector<double> _initial;
+    std::vector<double> _clicked;
+};
+
+} // namespace Helper
+
+#endif // HELPER_PERFORMANCE_COUNTERS_HPP
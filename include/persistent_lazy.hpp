@@ -0,0 +1,116 @@
+/***************************************************************************
+ *            persistent_lazy.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file persistent_lazy.hpp
+ *  \brief Lazy objects whose creation is memoized on disk across runs
+ */
+
+#ifndef HELPER_PERSISTENT_LAZY_HPP
+#define HELPER_PERSISTENT_LAZY_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "lazy.hpp"
+#include "snapshot.hpp"
+
+namespace Helper {
+
+//! \brief The key of a persistent computation, made of a name and of the inputs the result depends on
+//! \details Inputs are appended as bytes, strings being prefixed by their length so that different sequences of inputs never
+//! have the same bytes. The name should change whenever the computation or the serialization of its result changes.
+class MemoKey {
+  public:
+    MemoKey(std::string_view name) { add(name); }
+
+    //! \brief Append a string input
+    MemoKey& add(std::string_view input) {
+        add(static_cast<std::uint64_t>(input.size()));
+        _bytes.append(input);
+        return *this;
+    }
+    MemoKey& add(char const* input) { return add(std::string_view(input)); }
+    //! \brief Append an arithmetic, enumeration or padding-free input, as its bytes
+    //! \details Types with padding are rejected since equal values may differ in their padding bytes, and pointers are rejected
+    //! since their value changes between runs. Structs holding pointers cannot be detected and should be added member by member.
+    template<class T> requires ((std::is_arithmetic_v<T> or std::is_enum_v<T> or std::has_unique_object_representations_v<T>)
+                                and not std::is_pointer_v<T> and not std::is_member_pointer_v<T>)
+    MemoKey& add(T const& input) {
+        TrivialSerializer<T>().serialize(input, _bytes);
+        return *this;
+    }
+
+    //! \brief The bytes identifying the computation
+    std::string const& bytes() const { return _bytes; }
+    //! \brief The name of the file storing the result, derived from a hash of the bytes
+    std::string file_name() const;
+
+  private:
+    std::string _bytes;
+};
+
+//! \brief The directory of persistent results by default
+//! \details The \c HELPER_MEMO_DIRECTORY environment variable if set, otherwise a \c helper_memo subdirectory of the temporary directory.
+std::string default_memo_directory();
+
+//! \brief The path of the file storing the result of the computation of \a key in \a directory
+std::string memo_path(std::string const& directory, MemoKey const& key);
+
+//! \brief Store the serialized result \a value of the computation of \a key in \a directory, creating the directory if needed
+//! \details The file is a snapshot with a single record, whose label is the key, written to a temporary file and renamed.
+//! \return Whether the file was written successfully
+bool store_memo(std::string const& directory, MemoKey const& key, std::string_view value);
+
+//! \brief A lazy object created by \a func on first access, unless a result for \a key has been stored in \a directory by a previous run
+//! \details The stored file is memory-mapped and the object is deserialized from it, so that a previous result costs no more than
+//! reading it back. A missing, corrupt or mismatching file, or one that fails to deserialize, is ignored and \a func is run,
+//! after which its result is serialized and stored for the next runs; failing to store it is not an error. The returned object
+//! has the thread-safety of Lazy<O>. The serializer \a S has the interface of TrivialSerializer.
+template<class O, class S = TrivialSerializer<O>>
+Lazy<O> make_persistent_lazy(MemoKey key, function<O()> func, std::string directory = default_memo_directory(), S serializer = S()) {
+    return Lazy<O>([key = std::move(key), func = std::move(func), directory = std::move(directory), serializer = std::move(serializer)]() -> O* {
+        {
+            SnapshotReader reader(memo_path(directory, key), 0);
+            if (reader.is_valid() and reader.records().size() == 1 and reader.records().front().label == key.bytes()) {
+                try {
+                    return new O(serializer.deserialize(reader.records().front().value));
+                } catch (std::exception const&) { }
+            }
+        }
+        auto result = std::make_unique<O>(func());
+        std::string buffer;
+        serializer.serialize(*result, buffer);
+        store_memo(directory, key, buffer);
+        return result.release();
+    });
+}
+
+} // namespace Helper
+
+#endif // HELPER_PERSISTENT_LAZY_HPP
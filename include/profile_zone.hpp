@@ -0,0 +1,141 @@
+/***************************************************************************
+ *            profile_zone.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file profile_zone.hpp
+ *  \brief Scoped profiling zones, recorded per thread and aggregated into a call tree
+ *  \details The HELPER_PROFILE_SCOPE macro expands to nothing if HELPER_DISABLE_PROFILE_ZONES is defined.
+ */
+
+#ifndef HELPER_PROFILE_ZONE_HPP
+#define HELPER_PROFILE_ZONE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "cycle_clock.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief The entry into a zone, or the exit from the innermost open zone if \a name is null
+struct ZoneEvent {
+    char const* name;
+    //! \brief The time of the event, in nanoseconds of CycleClock
+    std::int64_t time;
+};
+
+//! \brief The events recorded by a thread, in order
+struct ThreadZoneEvents {
+    //! \brief The index of the thread, in order of its first recorded event
+    size_t thread_index;
+    std::vector<ZoneEvent> events;
+};
+
+//! \brief A node of the call tree of zones, aggregating all the calls of a zone with the same path of enclosing zones
+struct ZoneNode {
+    std::string name;
+    std::uint64_t calls = 0;
+    //! \brief The time spent in the zone in nanoseconds, including the enclosed zones
+    std::int64_t inclusive_time = 0;
+    //! \brief The time spent in the zone in nanoseconds, excluding the enclosed zones
+    std::int64_t exclusive_time = 0;
+    std::vector<ZoneNode> children;
+
+    //! \brief The child with the given name, or null if absent
+    ZoneNode const* child(std::string const& child_name) const;
+
+    //! \brief Print the tree, one zone per line indented by depth, with the calls and the times in milliseconds
+    friend std::ostream& operator<<(std::ostream& os, ZoneNode const& node);
+};
+
+//! \brief The recorder of the zones entered and exited by all threads
+//! \details Each thread appends to its own buffer, made of fixed-size blocks that are published with release stores, so that
+//! recording takes no lock and the buffers can be read by another thread at any time. Buffers outlive their threads, until
+//! cleared. Zone names are not copied, hence they must outlive the recorder, as string literals do.
+class ZoneProfiler {
+    struct Block;
+    struct Buffer;
+  public:
+    //! \brief The profiler shared by all zones
+    static ZoneProfiler& instance();
+
+    ZoneProfiler();
+    ZoneProfiler(ZoneProfiler const&) = delete;
+    ZoneProfiler& operator=(ZoneProfiler const&) = delete;
+    ~ZoneProfiler();
+
+    //! \brief Record the entry of the current thread into the zone \a name
+    void enter(char const* name) { _record(name); }
+    //! \brief Record the exit of the current thread from its innermost zone
+    void exit() { _record(nullptr); }
+
+    //! \brief The index of the current thread, as used in the events
+    size_t thread_index();
+
+    //! \brief The events recorded so far, for each thread that recorded any
+    std::vector<ThreadZoneEvents> events() const;
+    //! \brief The call tree of the zones completed so far, merged across threads, under an unnamed root with no time
+    ZoneNode call_tree() const;
+    //! \brief Discard the events recorded, which requires that no thread is recording meanwhile
+    void clear();
+
+  private:
+    void _record(char const* name);
+    Buffer& _buffer();
+  private:
+    std::uint64_t const _identifier;
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+//! \brief A zone of ZoneProfiler::instance(), entered on construction and exited on destruction
+class ProfileZone {
+  public:
+    ProfileZone(char const* name) { ZoneProfiler::instance().enter(name); }
+    ProfileZone(ProfileZone const&) = delete;
+    ProfileZone& operator=(ProfileZone const&) = delete;
+    ~ProfileZone() { ZoneProfiler::instance().exit(); }
+};
+
+} // namespace Helper
+
+#define HELPER_PROFILE_ZONE_CONCATENATE_IMPL(a,b) a##b
+#define HELPER_PROFILE_ZONE_CONCATENATE(a,b) HELPER_PROFILE_ZONE_CONCATENATE_IMPL(a,b)
+
+#ifndef HELPER_DISABLE_PROFILE_ZONES
+//! \brief Profile the rest of the enclosing scope as a zone named \a name, which must be a string literal
+#define HELPER_PROFILE_SCOPE(name) Helper::ProfileZone HELPER_PROFILE_ZONE_CONCATENATE(helper_profile_zone_,__LINE__)(name)
+#else
+#define HELPER_PROFILE_SCOPE(name)
+#endif
+
+#endif // HELPER_PROFILE_ZONE_HPP
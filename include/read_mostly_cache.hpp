@@ -0,0 +1,271 @@
+/***************************************************************************
+ *            read_mostly_cache.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file read_mostly_cache.hpp
+ *  \brief A thread-safe cache whose lookups take no locks, for workloads dominated by reads
+ */
+
+#ifndef HELPER_READ_MOSTLY_CACHE_HPP
+#define HELPER_READ_MOSTLY_CACHE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "macros.hpp"
+#include "metaprogramming.hpp"
+#include "epoch_reclamation.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A thread-safe cache of objects of type \a V indexed by a label \a L, with lock-free lookups
+//! \details Elements are immutable once inserted and indexed by an open-addressing hash table of atomic pointers. Readers only
+//! load pointers within an EpochDomain::Guard, hence they never wait for writers nor for each other; writers are serialised by
+//! a mutex, publish new elements with release stores and retire removed ones to the epoch domain, which deletes them once no reader
+//! can hold them. Recency is approximated by the CLOCK algorithm: a hit sets a reference bit of the element, written only if not
+//! already set so that hot elements are read without writes, and eviction sweeps a hand over the elements clearing the bits,
+//! evicting the first element found unreferenced. Values are returned by copy. Suitable when lookups vastly outnumber insertions,
+//! since each insertion or removal takes the writer lock.
+template<class L, class V, class H = std::hash<L>> class ReadMostlyCache {
+  private:
+    struct Node {
+        template<class... AS> Node(L const& l, size_t h, AS&&... args) : label(l), hash(h), value(std::forward<AS>(args)...), referenced(false), clock_index(0) { }
+        L const label;
+        size_t const hash;
+        V const value;
+        std::atomic<bool> referenced;
+        size_t clock_index;
+    };
+    struct Table {
+        Table(size_t size) : mask(size-1), buckets(new std::atomic<Node*>[size]()) { }
+        size_t size() const { return mask+1; }
+        size_t const mask;
+        std::unique_ptr<std::atomic<Node*>[]> buckets;
+    };
+    //! \brief The position of a label in a table, with the node if found
+    struct Probe {
+        size_t bucket;
+        Node* node;
+    };
+  public:
+    //! \brief Construct with a given \a maximum_size
+    ReadMostlyCache(size_t maximum_size) : _maximum_size(maximum_size), _size(0), _tombstones(0), _hand(0) {
+        HELPER_PRECONDITION(maximum_size>0);
+        HELPER_PRECONDITION(maximum_size<=std::numeric_limits<size_t>::max()/8);
+        _clock.resize(maximum_size,nullptr);
+        _table.store(new Table(_table_size()),std::memory_order_relaxed);
+    }
+
+    ReadMostlyCache(ReadMostlyCache const&) = delete;
+    ReadMostlyCache& operator=(ReadMostlyCache const&) = delete;
+
+    //! \brief Destroy the cache, which must not be accessed concurrently any more
+    ~ReadMostlyCache() {
+        for (size_t i=0; i<_size; ++i) delete _clock[i];
+        delete _table.load(std::memory_order_relaxed);
+    }
+
+    //! \brief Check whether the label is present, without marking it as referenced
+    bool has_label(L const& label) const {
+        EpochDomain::Guard guard;
+        return _probe(*_table.load(std::memory_order_acquire),label,_hash(label)).node != nullptr;
+    }
+
+    //! \brief Get a copy of the element identified with \a label
+    V get(L const& label) const {
+        auto result = try_get(label);
+        HELPER_ASSERT_MSG(result.has_value(), "Cache has no element for label " << label);
+        return std::move(result.value());
+    }
+
+    //! \brief Get a copy of the element identified with \a label, or nothing if not present
+    std::optional<V> try_get(L const& label) const {
+        EpochDomain::Guard guard;
+        Node* node = _probe(*_table.load(std::memory_order_acquire),label,_hash(label)).node;
+        if (node == nullptr) return std::nullopt;
+        if (not node->referenced.load(std::memory_order_relaxed)) node->referenced.store(true,std::memory_order_relaxed);
+        return node->value;
+    }
+
+    //! \brief Get a copy of the element identified with \a label, inserting the result of \a factory if not present
+    //! \details The factory is run without holding the writer lock, hence concurrent misses on the same label may each run it,
+    //! in which case the first value inserted is kept
+    template<class F> V get_or_compute(L const& label, F const& factory) {
+        auto result = try_get(label);
+        if (result.has_value()) return std::move(result.value());
+        V val = factory();
+        std::lock_guard<std::mutex> lock(_writer_mutex);
+        auto probe = _probe(*_table.load(std::memory_order_relaxed),label,_hash(label));
+        if (probe.node != nullptr) return probe.node->value;
+        return _insert(label,std::move(val))->value;
+    }
+
+    //! \brief Insert the element
+    //! \details The element must not already exist; evicts an element chosen by the CLOCK algorithm if the cache is full
+    template<ConvertibleTo<V> VV> void put(L const& label, VV&& val) {
+        std::lock_guard<std::mutex> lock(_writer_mutex);
+        HELPER_PRECONDITION(_probe(*_table.load(std::memory_order_relaxed),label,_hash(label)).node == nullptr);
+        _insert(label,std::forward<VV>(val));
+    }
+
+    //! \brief Remove the element identified with \a label, if present
+    //! \return Whether an element was removed
+    bool erase(L const& label) {
+        std::lock_guard<std::mutex> lock(_writer_mutex);
+        auto probe = _probe(*_table.load(std::memory_order_relaxed),label,_hash(label));
+        if (probe.node == nullptr) return false;
+        _unlink(probe);
+        size_t last = _size-1;
+        if (probe.node->clock_index != last) {
+            _clock[probe.node->clock_index] = _clock[last];
+            _clock[last]->clock_index = probe.node->clock_index;
+        }
+        _clock[last] = nullptr;
+        _size = last;
+        if (_hand >= _size) _hand = 0;
+        EpochDomain::instance().retire(probe.node);
+        return true;
+    }
+
+    //! \brief The current size
+    size_t current_size() const {
+        std::lock_guard<std::mutex> lock(_writer_mutex);
+        return _size;
+    }
+
+    //! \brief The maximum size
+    size_t maximum_size() const {
+        return _maximum_size;
+    }
+
+  private:
+    size_t _table_size() const {
+        return std::bit_ceil(2*_maximum_size);
+    }
+
+    static size_t _hash(L const& label) {
+        auto result = static_cast<std::uint64_t>(H()(label)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(result ^ (result >> 32));
+    }
+
+    static Node* _tombstone() {
+        static char marker;
+        return reinterpret_cast<Node*>(&marker);
+    }
+
+    //! \brief Find \a label by linear probing from its hash, skipping removed elements
+    static Probe _probe(Table const& table, L const& label, size_t hash) {
+        for (size_t i = hash & table.mask; ; i = (i+1) & table.mask) {
+            Node* node = table.buckets[i].load(std::memory_order_acquire);
+            if (node == nullptr) return {i, nullptr};
+            if (node != _tombstone() and node->hash == hash and node->label == label) return {i, node};
+        }
+    }
+
+    //! \brief Insert a new node, evicting first if full; requires the writer lock
+    template<class... AS> Node* _insert(L const& label, AS&&... args) {
+        size_t hash = _hash(label);
+        auto node = std::make_unique<Node>(label, hash, std::forward<AS>(args)...);
+        size_t index = (_size == _maximum_size ? _evict() : _size++);
+        node->clock_index = index;
+        Table* table = _table.load(std::memory_order_relaxed);
+        if (4*(_size+_tombstones) > 3*table->size()) table = _rebuild();
+        size_t i = hash & table->mask;
+        while (true) {
+            Node* current = table->buckets[i].load(std::memory_order_relaxed);
+            if (current == nullptr) break;
+            if (current == _tombstone()) {
+                --_tombstones;
+                break;
+            }
+            i = (i+1) & table->mask;
+        }
+        _clock[index] = node.get();
+        table->buckets[i].store(node.get(), std::memory_order_release);
+        return node.release();
+    }
+
+    //! \brief Evict the first unreferenced element found by the hand, returning its index in the clock
+    size_t _evict() {
+        while (true) {
+            Node* node = _clock[_hand];
+            if (node->referenced.load(std::memory_order_relaxed)) {
+                node->referenced.store(false, std::memory_order_relaxed);
+                _hand = (_hand+1) % _size;
+                continue;
+            }
+            size_t result = _hand;
+            _unlink(_probe(*_table.load(std::memory_order_relaxed),node->label,node->hash));
+            EpochDomain::instance().retire(node);
+            _clock[result] = nullptr;
+            _hand = (_hand+1) % _size;
+            return result;
+        }
+    }
+
+    //! \brief Replace the bucket of a found node with a tombstone, so that probing continues past it
+    void _unlink(Probe const& probe) {
+        _table.load(std::memory_order_relaxed)->buckets[probe.bucket].store(_tombstone(), std::memory_order_release);
+        ++_tombstones;
+    }
+
+    //! \brief Publish a table with the current nodes and no tombstones, retiring the previous one
+    Table* _rebuild() {
+        Table* table = new Table(_table_size());
+        for (size_t i=0; i<_clock.size(); ++i) {
+            Node* node = _clock[i];
+            if (node == nullptr) continue;
+            size_t j = node->hash & table->mask;
+            while (table->buckets[j].load(std::memory_order_relaxed) != nullptr) j = (j+1) & table->mask;
+            table->buckets[j].store(node, std::memory_order_relaxed);
+        }
+        EpochDomain::instance().retire(_table.exchange(table, std::memory_order_acq_rel));
+        _tombstones = 0;
+        return table;
+    }
+
+  private:
+    size_t const _maximum_size;
+    alignas(64) std::atomic<Table*> _table;
+    alignas(64) mutable std::mutex _writer_mutex;
+    std::vector<Node*> _clock;
+    size_t _size;
+    size_t _tombstones;
+    size_t _hand;
+};
+
+} // namespace Helper
+
+#endif // HELPER_READ_MOSTLY_CACHE_HPP
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *            snapshot.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file snapshot.hpp
+ *  \brief Binary snapshot files of labelled records, for persisting the contents of caches
+ */
+
+#ifndef HELPER_SNAPSHOT_HPP
+#define HELPER_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "macros.hpp"
+#include "mapped_file.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief Serialization of trivially copyable objects as their bytes
+//! \details A serializer of \a T appends the bytes of an object to a buffer and constructs an object back from a range of bytes,
+//! throwing if the bytes are malformed. The bytes are not required to be aligned.
+template<class T> struct TrivialSerializer {
+    static_assert(std::is_trivially_copyable<T>::value, "TrivialSerializer requires a trivially copyable type");
+    void serialize(T const& obj, std::string& buffer) const {
+        buffer.append(reinterpret_cast<char const*>(&obj), sizeof(T));
+    }
+    T deserialize(std::string_view bytes) const;
+};
+
+//! \brief A record of a snapshot, referring to the bytes of the label and of the value
+struct SnapshotRecord {
+    std::string_view label;
+    std::string_view value;
+    std::uint64_t weight;
+    //! \brief The expiry as nanoseconds since the epoch of \c std::chrono::system_clock, or negative if the record does not expire
+    //! \details Wall-clock time is used since it carries across runs, unlike a steady clock or a time to live relative to the save
+    std::int64_t expiry;
+};
+
+//! \brief A builder of a snapshot file
+//! \details The file starts with a header holding a magic number, the format version, a user-defined \a version and the number
+//! of records, and ends with a checksum of everything before it. The file is written to a unique temporary path and then renamed,
+//! so that a crash while writing never leaves a truncated snapshot in place.
+class SnapshotWriter {
+  public:
+    //! \brief Start a snapshot with a user-defined \a version, to be increased whenever the serialization of labels or values changes
+    SnapshotWriter(std::uint32_t version);
+
+    //! \brief The buffer to append the label of the next record to
+    std::string& buffer() { return _buffer; }
+    //! \brief Begin a record; the label and then the value must be serialized into the buffer, each followed by a call to end_field
+    void begin_record(std::uint64_t weight, std::int64_t expiry);
+    //! \brief End the label or the value of the current record
+    void end_field();
+
+    //! \brief The number of records
+    size_t number_of_records() const { return _number_of_records; }
+
+    //! \brief Write the snapshot to \a path
+    //! \return Whether the file was written successfully
+    bool write(std::string const& path);
+
+  private:
+    std::string _buffer;
+    size_t _field_start;
+    size_t _number_of_fields;
+    size_t _number_of_records;
+};
+
+//! \brief A reader of a snapshot file, which is memory-mapped rather than read
+//! \details On construction the header and the checksum are validated, and the records are indexed without copying their bytes:
+//! a missing, truncated, corrupt or version-mismatched file yields an invalid reader with no records.
+class SnapshotReader {
+  public:
+    //! \brief Open the snapshot at \a path, expected to have the user-defined \a version
+    SnapshotReader(std::string const& path, std::uint32_t version);
+
+    //! \brief Whether the file is a valid snapshot
+    bool is_valid() const { return _valid; }
+    //! \brief The records, in the order they were written; they refer to the mapped file, hence they live as long as the reader
+    std::vector<SnapshotRecord> const& records() const { return _records; }
+
+  private:
+    bool _parse(std::uint32_t version);
+  private:
+    MappedFile _file;
+    std::vector<SnapshotRecord> _records;
+    bool _valid;
+};
+
+template<class T> T TrivialSerializer<T>::deserialize(std::string_view bytes) const {
+    if (bytes.size() != sizeof(T)) throw std::length_error("Expected " + std::to_string(sizeof(T)) + " bytes, found " + std::to_string(bytes.size()));
+    T result;
+    std::memcpy(&result, bytes.data(), sizeof(T));
+    return result;
+}
+
+} // namespace Helper
+
+#endif // HELPER_SNAPSHOT_HPP
@@ -34,6 +34,7 @@
 #define HELPER_STOPWATCH_HPP
 
 #include <chrono>
+#include "cycle_clock.hpp"
 
 namespace Helper {
 
@@ -41,9 +42,10 @@ using Seconds = std::chrono::seconds;
 using Milliseconds = std::chrono::milliseconds;
 using Microseconds = std::chrono::microseconds;
 
-template<class D> class Stopwatch {
+//! \brief A stopwatch measuring durations of type \a D using the clock \a C
+template<class D, class C = std::chrono::high_resolution_clock> class Stopwatch {
 public:
-    using ResolutionType = std::chrono::high_resolution_clock;
+    using ResolutionType = C;
     using TimePointType = std::chrono::time_point<ResolutionType>;
 
     Stopwatch() { restart(); }
@@ -53,6 +55,11 @@ public:
     //! \brief Get the duration in seconds, in double precision
     double elapsed_seconds() const { return std::chrono::duration_cast<std::chrono::duration<double>>(duration()).count(); }
 
+    //! \brief The time of the last restart
+    TimePointType initial() const { return _initial; }
+    //! \brief The time of the last click
+    TimePointType clicked() const { return _clicked; }
+
     //! \brief Restart the watch time to zero
     Stopwatch& restart() { _initial = ResolutionType::now(); _clicked = _initial; return *this; }
     //! \brief Save the current time
@@ -63,6 +70,9 @@ private:
     TimePointType _clicked;
 };
 
+//! \brief A stopwatch reading the time stamp counter, for intervals too short for the overhead of the system clock
+template<class D> using CycleStopwatch = Stopwatch<D,CycleClock>;
+
 } // namespace Helper
 
 #endif /* HELPER_STOPWATCH_HPP */
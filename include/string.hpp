@@ -34,6 +34,7 @@
 #define HELPER_STRING_HPP
 
 #include <string>
+#include <string_view>
 #include <sstream>
 
 namespace Helper {
@@ -58,4 +59,14 @@ template<> inline String class_name<String>() { return "String"; }
 
 } // namespace Helper
 
+namespace std {
+
+//! \brief Hash of strings, transparent so that caches of String labels can be searched by any string-like key
+template<> struct hash<Helper::String> {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return hash<std::string_view>()(str); }
+};
+
+} // namespace std
+
 #endif /* HELPER_STRING_HPP */
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *            thread_pool.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file thread_pool.hpp
+ *  \brief A fixed set of worker threads running queued tasks
+ */
+
+#ifndef HELPER_THREAD_POOL_HPP
+#define HELPER_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A pool of worker threads running tasks in the order they are enqueued
+//! \details Exceptions thrown by tasks are discarded. On destruction, the tasks still queued are run before joining the workers.
+class ThreadPool {
+  public:
+    //! \brief Construct with a given number of worker threads, at least one
+    ThreadPool(size_t num_threads);
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ~ThreadPool();
+
+    //! \brief The pool shared by default, with one thread per core
+    static ThreadPool& global();
+
+    //! \brief Queue \a task to be run by a worker
+    void enqueue(std::function<void()> task);
+
+    //! \brief The number of worker threads
+    size_t num_threads() const { return _threads.size(); }
+    //! \brief The number of tasks queued and not started yet
+    size_t queue_size() const;
+
+  private:
+    void _work();
+  private:
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _stopping;
+    std::vector<std::thread> _threads;
+};
+
+} // namespace Helper
+
+#endif // HELPER_THREAD_POOL_HPP
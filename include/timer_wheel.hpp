@@ -0,0 +1,206 @@
+/***************************************************************************
+ *            timer_wheel.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file timer_wheel.hpp
+ *  \brief A hierarchical timer wheel for expiring a large number of keys in constant time per operation
+ */
+
+#ifndef HELPER_TIMER_WHEEL_HPP
+#define HELPER_TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <list>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include "macros.hpp"
+
+namespace Helper {
+
+using std::size_t;
+
+//! \brief A hierarchical timer wheel of keys of type \a K, each expiring at a deadline
+//! \details Time is discretised into ticks of a given resolution. The first level has one slot per tick for the next 64 ticks,
+//! and each following level has slots 64 times coarser: keys are moved down a level when the time reaches their slot, hence
+//! scheduling, cancelling and expiring a key take constant time, independently of the number of keys. Deadlines beyond the
+//! range of the last level are parked in its farthest slot and rescheduled when reached. Deadlines are rounded up to the next tick.
+//! Each level keeps a bitmap of its occupied slots, from which advancing finds the next tick at which keys expire or move down,
+//! hence it jumps over the ticks with nothing to do instead of stepping through the elapsed time.
+template<class K, class H = std::hash<K>> class TimerWheel {
+  public:
+    using ClockType = std::chrono::steady_clock;
+    using TimePointType = ClockType::time_point;
+    using DurationType = ClockType::duration;
+  private:
+    static constexpr size_t NUM_LEVELS = 4;
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr uint64_t NUM_SLOTS = uint64_t(1) << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = NUM_SLOTS-1;
+    //! \brief The level of the keys being expired, which are in the expiring list rather than in a slot
+    static constexpr size_t EXPIRING = NUM_LEVELS;
+    using SlotList = std::list<K const*>;
+    struct Position {
+        uint64_t deadline;
+        size_t level;
+        uint64_t slot;
+        typename SlotList::iterator iterator;
+    };
+  public:
+    //! \brief Construct with ticks of given \a resolution, starting from \a start
+    TimerWheel(DurationType resolution, TimePointType start = ClockType::now()) : _resolution(resolution), _start(start), _current_tick(0), _occupied({}) {
+        HELPER_PRECONDITION(resolution.count()>0);
+    }
+
+    //! \brief The number of scheduled keys
+    size_t size() const { return _positions.size(); }
+    //! \brief Whether no key is scheduled
+    bool empty() const { return _positions.empty(); }
+    //! \brief Whether \a key is scheduled
+    bool contains(K const& key) const { return _positions.find(key) != _positions.end(); }
+
+    //! \brief Schedule \a key to expire at \a deadline, replacing any previous deadline
+    //! \details A deadline not later than the current time expires at the next advance
+    void schedule(K const& key, TimePointType deadline) {
+        cancel(key);
+        auto p = _positions.emplace(key,Position({_tick_of(deadline),0,0,typename SlotList::iterator()})).first;
+        _place(p,_current_tick+1);
+    }
+
+    //! \brief Remove \a key, if scheduled
+    void cancel(K const& key) {
+        auto p = _positions.find(key);
+        if (p == _positions.end()) return;
+        if (p->second.level == EXPIRING) {
+            _expiring.erase(p->second.iterator);
+        } else {
+            auto& slot = _slots[p->second.level][p->second.slot];
+            slot.erase(p->second.iterator);
+            if (slot.empty()) _occupied[p->second.level] &= ~(uint64_t(1) << p->second.slot);
+        }
+        _positions.erase(p);
+    }
+
+    //! \brief Advance the time to \a now, calling \a on_expire on each key whose deadline has passed
+    //! \details Expired keys are removed before \a on_expire is called on them, which may hence schedule or cancel keys, including
+    //! keys expiring at the same tick whose turn has not come yet: cancelling or rescheduling them prevents their expiry.
+    template<class F> void advance(TimePointType now, F const& on_expire) {
+        uint64_t target_tick = (now < _start ? 0 : static_cast<uint64_t>((now-_start)/_resolution));
+        while (_current_tick < target_tick) {
+            uint64_t next_tick = _next_event_tick();
+            if (next_tick > target_tick) { _current_tick = target_tick; break; }
+            _current_tick = next_tick;
+            _cascade();
+            _expire(on_expire);
+        }
+    }
+
+  private:
+    uint64_t _tick_of(TimePointType time) const {
+        if (time <= _start) return 0;
+        auto elapsed = time-_start;
+        auto ticks = static_cast<uint64_t>(elapsed/_resolution);
+        return (ticks*_resolution < elapsed ? ticks+1 : ticks);
+    }
+
+    //! \brief The first tick after the current one at which a slot holding keys is reached, or the maximum tick if none
+    //! \details An occupied slot of a level is reached when the ticks of all lower levels wrap to zero and the index of the level
+    //! equals the slot, which happens within one revolution of the level
+    uint64_t _next_event_tick() const {
+        uint64_t result = std::numeric_limits<uint64_t>::max();
+        for (size_t level = 0; level < NUM_LEVELS; ++level) {
+            if (_occupied[level] == 0) continue;
+            uint64_t revolution_position = _current_tick >> (SLOT_BITS*level);
+            int first = static_cast<int>((revolution_position + 1) & SLOT_MASK);
+            auto steps = static_cast<uint64_t>(std::countr_zero(std::rotr(_occupied[level], first))) + 1;
+            result = std::min(result, (revolution_position + steps) << (SLOT_BITS*level));
+        }
+        return result;
+    }
+
+    //! \brief Place the key in the slot of the lowest level whose range covers its deadline, not earlier than \a minimum_tick
+    void _place(typename std::unordered_map<K,Position,H>::iterator p, uint64_t minimum_tick) {
+        auto& position = p->second;
+        uint64_t deadline = std::max(position.deadline,minimum_tick);
+        uint64_t delta = deadline-_current_tick;
+        size_t level = 0;
+        while (level+1 < NUM_LEVELS and delta >= (uint64_t(1) << (SLOT_BITS*(level+1)))) ++level;
+        if (delta >= (uint64_t(1) << (SLOT_BITS*NUM_LEVELS)))
+            deadline = _current_tick + (SLOT_MASK << (SLOT_BITS*(NUM_LEVELS-1)));
+        position.level = level;
+        position.slot = (deadline >> (SLOT_BITS*level)) & SLOT_MASK;
+        auto& slot = _slots[level][position.slot];
+        position.iterator = slot.insert(slot.end(),&p->first);
+        _occupied[level] |= uint64_t(1) << position.slot;
+    }
+
+    //! \brief Move down the keys of the higher-level slots reached at the current tick, starting from the highest one
+    void _cascade() {
+        size_t top_level = 0;
+        while (top_level+1 < NUM_LEVELS and ((_current_tick >> (SLOT_BITS*(top_level))) & SLOT_MASK) == 0) ++top_level;
+        for (size_t level = top_level; level > 0; --level) {
+            uint64_t slot = (_current_tick >> (SLOT_BITS*level)) & SLOT_MASK;
+            SlotList keys;
+            keys.swap(_slots[level][slot]);
+            _occupied[level] &= ~(uint64_t(1) << slot);
+            for (auto key : keys) _place(_positions.find(*key),_current_tick);
+        }
+    }
+
+    //! \brief Expire the keys of the first-level slot reached at the current tick
+    //! \details The keys are moved to a list of their own, so that \a on_expire cancelling or rescheduling one of them removes it
+    //! from that list rather than from the slot, which may have been filled again meanwhile
+    template<class F> void _expire(F const& on_expire) {
+        _expiring.swap(_slots[0][_current_tick & SLOT_MASK]);
+        _occupied[0] &= ~(uint64_t(1) << (_current_tick & SLOT_MASK));
+        for (auto key : _expiring) _positions.find(*key)->second.level = EXPIRING;
+        while (not _expiring.empty()) {
+            auto p = _positions.find(*_expiring.front());
+            _expiring.pop_front();
+            auto node = _positions.extract(p);
+            on_expire(node.key());
+        }
+    }
+
+  private:
+    DurationType const _resolution;
+    TimePointType const _start;
+    uint64_t _current_tick;
+    std::array<std::array<SlotList,NUM_SLOTS>,NUM_LEVELS> _slots;
+    //! \brief The bitmap of the slots holding keys, for each level
+    std::array<uint64_t,NUM_LEVELS> _occupied;
+    //! \brief The keys expired at the current tick whose \a on_expire has not been called yet
+    SlotList _expiring;
+    std::unordered_map<K,Position,H> _positions;
+};
+
+} // namespace Helper
+
+#endif // HELPER_TIMER_WHEEL_HPP
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *            profile.hpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file profile.hpp
+ *  \brief Minimal harness for the profiling executables.
+ */
+
+#ifndef HELPER_PROFILE_HPP
+#define HELPER_PROFILE_HPP
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "stopwatch.hpp"
+#include "string.hpp"
+
+namespace Helper {
+
+using Nanoseconds = std::chrono::nanoseconds;
+
+//! \brief Base class for profiling suites, printing the average time per try of a given function
+class Profiler {
+  public:
+    Profiler(size_t num_tries) : _num_tries(num_tries) { }
+
+    //! \brief The default number of tries
+    size_t num_tries() const { return _num_tries; }
+
+    //! \brief Run \a f for \a num_tries times, print and return the average nanoseconds per try
+    //! \details The function takes the index of the try as argument
+    template<class F> double profile(String const& msg, F const& f, size_t num_tries) {
+        Stopwatch<Nanoseconds> sw;
+        for (size_t i=0; i<num_tries; ++i) f(i);
+        double result = static_cast<double>(sw.click().duration().count())/static_cast<double>(num_tries);
+        std::cout << std::left << std::setw(48) << msg << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result << " ns" << std::endl;
+        return result;
+    }
+
+    template<class F> double profile(String const& msg, F const& f) { return profile(msg,f,_num_tries); }
+
+    //! \brief Run \a f for \a num_tries times split among \a num_threads threads, print and return the wall-clock nanoseconds per try
+    //! \details The function takes the index of the thread and the index of the try as arguments
+    template<class F> double profile_parallel(String const& msg, F const& f, size_t num_threads, size_t num_tries) {
+        std::vector<std::thread> threads;
+        size_t tries_per_thread = num_tries/num_threads;
+        Stopwatch<Nanoseconds> sw;
+        for (size_t t=0; t<num_threads; ++t)
+            threads.emplace_back([&f,t,tries_per_thread]{ for (size_t i=0; i<tries_per_thread; ++i) f(t,i); });
+        for (auto& thread : threads) thread.join();
+        double result = static_cast<double>(sw.click().duration().count())/static_cast<double>(tries_per_thread*num_threads);
+        std::cout << std::left << std::setw(48) << msg << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result << " ns" << std::endl;
+        return result;
+    }
+
+  private:
+    size_t const _num_tries;
+};
+
+} // namespace Helper
+
+#endif // HELPER_PROFILE_HPP
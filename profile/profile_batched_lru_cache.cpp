@@ -0,0 +1,97 @@
+/***************************************************************************
+ *            profile_batched_lru_cache.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "concurrent_lru_cache.hpp"
+#include "randomiser.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+struct ProfileBatchedLRUCache : public Profiler {
+
+    ProfileBatchedLRUCache() : Profiler(4000000) { }
+
+    void run() {
+        profile_hits();
+        profile_concurrent_hits();
+    }
+
+    //! \brief Hits on a single cache, looking up one label at a time or a whole batch, in nanoseconds per batch
+    void profile_hits() {
+        LRUCache<size_t,size_t> cache(maximum_size);
+        for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+        auto labels = random_labels();
+        for (size_t batch_size = 16; batch_size <= 1024; batch_size *= 4) {
+            size_t num_batches = num_tries()/batch_size;
+            profile("Per-label hits, batch of " + to_string(batch_size), [&](size_t i){
+                for (size_t j=0; j<batch_size; ++j) cache.get(labels[(i*batch_size+j)%labels.size()]);
+            }, num_batches);
+            profile("Batched hits, batch of " + to_string(batch_size), [&](size_t i){
+                cache.get_many(_batch(labels,i,batch_size));
+            }, num_batches);
+        }
+    }
+
+    //! \brief Hits on a sharded cache from multiple threads, where batching acquires each lock once per batch
+    void profile_concurrent_hits() {
+        ConcurrentLRUCache<size_t,size_t> cache(2*maximum_size,64);
+        for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+        auto labels = random_labels();
+        size_t const batch_size = 256;
+        size_t num_batches = num_tries()/batch_size;
+        for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 4) {
+            profile_parallel("Per-label sharded hits, " + to_string(num_threads) + " threads", [&](size_t t, size_t i){
+                for (size_t j=0; j<batch_size; ++j) cache.get(labels[((t*7919+i)*batch_size+j)%labels.size()]);
+            }, num_threads, num_batches);
+            profile_parallel("Batched sharded hits, " + to_string(num_threads) + " threads", [&](size_t t, size_t i){
+                cache.get_many(_batch(labels,t*7919+i,batch_size));
+            }, num_threads, num_batches);
+        }
+    }
+
+  private:
+    std::vector<size_t> random_labels() {
+        UniformIntRandomiser<size_t> rnd(0,maximum_size-1);
+        std::vector<size_t> result;
+        for (size_t i=0; i<maximum_size; ++i) result.push_back(rnd.get());
+        return result;
+    }
+
+    //! \brief The \a i-th batch of labels, wrapping around
+    static std::span<size_t const> _batch(std::vector<size_t> const& labels, size_t i, size_t batch_size) {
+        size_t num_batches = labels.size()/batch_size;
+        return std::span<size_t const>(labels).subspan((i%num_batches)*batch_size,batch_size);
+    }
+
+    size_t const maximum_size = 1<<16;
+    size_t const max_threads = 2*std::max(std::thread::hardware_concurrency(),8u);
+};
+
+int main() {
+    ProfileBatchedLRUCache().run();
+}
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *            profile_concurrent_lru_cache.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <mutex>
+#include "concurrent_lru_cache.hpp"
+#include "randomiser.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+struct ProfileConcurrentLRUCache : public Profiler {
+
+    ProfileConcurrentLRUCache() : Profiler(4000000) { }
+
+    void run() {
+        profile_locked_hits();
+        profile_sharded_hits();
+    }
+
+    //! \brief Hits on a single cache behind one mutex, as a baseline
+    void profile_locked_hits() {
+        LRUCache<size_t,size_t> cache(maximum_size);
+        std::mutex mutex;
+        for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+        auto labels = random_labels();
+        for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+            profile_parallel("Locked hits with " + to_string(num_threads) + " threads", [&](size_t t, size_t i){
+                std::lock_guard<std::mutex> lock(mutex);
+                cache.get(labels[(t*7919+i)%labels.size()]);
+            }, num_threads, num_tries());
+        }
+    }
+
+    //! \brief Hits on a sharded cache with room for the imbalance between shards, whose time per hit should decrease with the number of threads up to the number of cores
+    void profile_sharded_hits() {
+        ConcurrentLRUCache<size_t,size_t> cache(2*maximum_size,64);
+        for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+        auto labels = random_labels();
+        for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+            profile_parallel("Sharded hits with " + to_string(num_threads) + " threads", [&](size_t t, size_t i){
+                cache.get(labels[(t*7919+i)%labels.size()]);
+            }, num_threads, num_tries());
+        }
+    }
+
+  private:
+    std::vector<size_t> random_labels() {
+        UniformIntRandomiser<size_t> rnd(0,maximum_size-1);
+        std::vector<size_t> result;
+        for (size_t i=0; i<maximum_size; ++i) result.push_back(rnd.get());
+        return result;
+    }
+
+    size_t const maximum_size = 1<<16;
+    size_t const max_threads = 2*std::max(std::thread::hardware_concurrency(),8u);
+};
+
+int main() {
+    ProfileConcurrentLRUCache().run();
+}
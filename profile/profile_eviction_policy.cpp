@@ -0,0 +1,105 @@
+/***************************************************************************
+ *            profile_eviction_policy.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include "lru_cache.hpp"
+#include "eviction_policy.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+using Trace = std::vector<size_t>;
+
+struct ProfileEvictionPolicy : public Profiler {
+
+    ProfileEvictionPolicy() : Profiler(2000000), _engine(42) { }
+
+    void run() {
+        Trace zipfian = zipfian_trace(num_tries());
+        Trace scan_mixed = scan_mixed_trace(num_tries());
+        for (size_t maximum_size : {size_t(1000), size_t(10000)}) {
+            profile_policy<LRUEviction<size_t>>("LRU", "Zipfian", zipfian, maximum_size);
+            profile_policy<TwoQueueEviction<size_t>>("2Q", "Zipfian", zipfian, maximum_size);
+            profile_policy<ARCEviction<size_t>>("ARC", "Zipfian", zipfian, maximum_size);
+            profile_policy<TinyLFUEviction<size_t>>("W-TinyLFU", "Zipfian", zipfian, maximum_size);
+            profile_policy<LRUEviction<size_t>>("LRU", "scan-mixed", scan_mixed, maximum_size);
+            profile_policy<TwoQueueEviction<size_t>>("2Q", "scan-mixed", scan_mixed, maximum_size);
+            profile_policy<ARCEviction<size_t>>("ARC", "scan-mixed", scan_mixed, maximum_size);
+            profile_policy<TinyLFUEviction<size_t>>("W-TinyLFU", "scan-mixed", scan_mixed, maximum_size);
+        }
+    }
+
+    //! \brief Replay \a trace on a cache with eviction policy \a P, printing the time per access and the hit ratio
+    template<class P> void profile_policy(String const& policy_name, String const& trace_name, Trace const& trace, size_t maximum_size) {
+        LRUCache<size_t,size_t,P> cache(maximum_size);
+        size_t hits = 0;
+        profile(policy_name + " on " + trace_name + " with maximum size " + to_string(maximum_size), [&](size_t i){
+            if (cache.has_label(trace[i])) { cache.get(trace[i]); ++hits; }
+            else cache.put(trace[i],i);
+        }, trace.size());
+        std::cout << "    hit ratio: " << std::setprecision(2) << 100.0*static_cast<double>(hits)/static_cast<double>(trace.size()) << "%" << std::endl;
+    }
+
+  private:
+    //! \brief A trace of labels drawn from a Zipfian distribution with exponent close to one over a large universe
+    Trace zipfian_trace(size_t length) {
+        size_t const universe = 100000;
+        double const exponent = 0.99;
+        std::vector<double> cumulative(universe);
+        double sum = 0;
+        for (size_t k=0; k<universe; ++k) { sum += 1.0/std::pow(static_cast<double>(k+1),exponent); cumulative[k] = sum; }
+        std::uniform_real_distribution<double> distribution(0,sum);
+        Trace result;
+        result.reserve(length);
+        for (size_t i=0; i<length; ++i)
+            result.push_back(static_cast<size_t>(std::lower_bound(cumulative.begin(),cumulative.end(),distribution(_engine))-cumulative.begin()));
+        return result;
+    }
+
+    //! \brief A Zipfian trace where every 20000 accesses a scan of 5000 labels never seen before is inserted
+    Trace scan_mixed_trace(size_t length) {
+        Trace zipfian = zipfian_trace(length);
+        Trace result;
+        result.reserve(length);
+        size_t next_cold_label = 1000000;
+        for (size_t i=0; result.size()<length; ++i) {
+            if (i>0 and i%20000 == 0)
+                for (size_t j=0; j<5000 and result.size()<length; ++j) result.push_back(next_cold_label++);
+            if (result.size()<length) result.push_back(zipfian[i]);
+        }
+        return result;
+    }
+
+    std::mt19937 _engine;
+};
+
+int main() {
+    ProfileEvictionPolicy().run();
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+ *            profile_heterogeneous_lookup.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include "container.hpp"
+#include "lru_cache.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+namespace {
+std::atomic<size_t> num_allocations(0);
+}
+
+void* operator new(size_t size) {
+    num_allocations.fetch_add(1,std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+struct ProfileHeterogeneousLookup : public Profiler {
+
+    ProfileHeterogeneousLookup() : Profiler(1000000) {
+        for (size_t i=0; i<num_labels; ++i) _labels.push_back("a label long enough to need an allocation " + to_string(i));
+    }
+
+    void run() {
+        profile_lru_cache();
+        profile_map();
+    }
+
+    //! \brief Lookups by a string view, either constructing a String or not
+    void profile_lru_cache() {
+        LRUCache<String,size_t> cache(num_labels);
+        for (size_t i=0; i<num_labels; ++i) cache.put(_labels[i],i);
+        profile_allocations("LRUCache get constructing String", [&](size_t i){ cache.get(String(std::string(_view(i)))); });
+        profile_allocations("LRUCache get by string_view", [&](size_t i){ cache.get(_view(i)); });
+    }
+
+    //! \brief Lookups by a C string, either constructing a String or not
+    void profile_map() {
+        Map<String,size_t,std::less<>> map;
+        for (size_t i=0; i<num_labels; ++i) map.insert(_labels[i],i);
+        profile_allocations("Map get constructing String", [&](size_t i){ map.get(String(_labels[i%num_labels].c_str())); });
+        profile_allocations("Map get by C string", [&](size_t i){ map.get(_labels[i%num_labels].c_str()); });
+    }
+
+  private:
+    std::string_view _view(size_t i) const { return _labels[i%num_labels]; }
+
+    //! \brief Profile \a f and print the number of heap allocations per try
+    template<class F> void profile_allocations(String const& msg, F const& f) {
+        size_t before = num_allocations.load();
+        profile(msg,f);
+        double allocations = static_cast<double>(num_allocations.load()-before)/static_cast<double>(num_tries());
+        std::cout << std::left << std::setw(48) << "  allocations per lookup" << std::right << std::fixed << std::setprecision(2) << std::setw(12) << allocations << std::endl;
+    }
+
+    size_t const num_labels = 1024;
+    std::vector<String> _labels;
+};
+
+int main() {
+    ProfileHeterogeneousLookup().run();
+}
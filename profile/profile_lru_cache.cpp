@@ -0,0 +1,75 @@
+/***************************************************************************
+ *            profile_lru_cache.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lru_cache.hpp"
+#include "randomiser.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+struct ProfileLRUCache : public Profiler {
+
+    ProfileLRUCache() : Profiler(1000000) { }
+
+    void run() {
+        profile_hit_latency();
+        profile_miss_insertion();
+    }
+
+    //! \brief The latency of a hit should not depend on the maximum size
+    void profile_hit_latency() {
+        for (size_t maximum_size = 16; maximum_size <= 1<<20; maximum_size *= 16) {
+            LRUCache<size_t,size_t> cache(maximum_size);
+            for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+            auto labels = random_labels(maximum_size);
+            profile("Hit with maximum size " + to_string(maximum_size), [&](size_t i){ cache.get(labels[i]); });
+        }
+    }
+
+    //! \brief The latency of an insertion with eviction should not depend on the maximum size
+    void profile_miss_insertion() {
+        for (size_t maximum_size = 16; maximum_size <= 1<<20; maximum_size *= 16) {
+            LRUCache<size_t,size_t> cache(maximum_size);
+            for (size_t i=0; i<maximum_size; ++i) cache.put(i,i);
+            profile("Insertion with eviction with maximum size " + to_string(maximum_size), [&](size_t i){ cache.put(maximum_size+i,i); });
+        }
+    }
+
+  private:
+    std::vector<size_t> random_labels(size_t maximum_size) {
+        UniformIntRandomiser<size_t> rnd(0,maximum_size-1);
+        std::vector<size_t> result;
+        result.reserve(num_tries());
+        for (size_t i=0; i<num_tries(); ++i) result.push_back(rnd.get());
+        return result;
+    }
+};
+
+int main() {
+    ProfileLRUCache().run();
+}
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *            profile_stopwatch.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "stopwatch.hpp"
+#include "profile.hpp"
+
+using namespace Helper;
+
+struct ProfileStopwatch : public Profiler {
+
+    ProfileStopwatch() : Profiler(10000000) { }
+
+    void run() {
+        std::cout << "Time stamp counter used: " << CycleClock::uses_time_stamp_counter() << std::endl;
+        profile_click<Stopwatch<Nanoseconds>>("High resolution clock click");
+        profile_click<Stopwatch<Nanoseconds,std::chrono::steady_clock>>("Steady clock click");
+        profile_click<CycleStopwatch<Nanoseconds>>("Cycle clock click");
+    }
+
+    //! \brief The cost of a click, dominated by reading the clock
+    template<class S> void profile_click(String const& msg) {
+        S sw;
+        profile(msg, [&sw](size_t){ sw.click(); });
+        if (sw.duration().count() < 0) std::cout << "Negative duration" << std::endl;
+    }
+};
+
+int main() {
+    ProfileStopwatch().run();
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *            access_trace.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include "access_trace.hpp"
+
+namespace Helper {
+
+namespace {
+
+constexpr char MAGIC[8] = {'H','L','P','T','R','A','C','E'};
+
+} // namespace
+
+AccessTraceWriter::AccessTraceWriter(std::string const& path) : _stream(path, std::ios::binary | std::ios::app), _number_of_accesses(0) {
+    _buffer.reserve(BUFFER_SIZE);
+    _stream.seekp(0, std::ios::end);
+    if (_stream.tellp() == 0) _stream.write(MAGIC, sizeof(MAGIC));
+}
+
+AccessTraceWriter::~AccessTraceWriter() {
+    flush();
+}
+
+void AccessTraceWriter::flush() {
+    _stream.write(reinterpret_cast<char const*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()*sizeof(std::uint64_t)));
+    _stream.flush();
+    _number_of_accesses += _buffer.size();
+    _buffer.clear();
+}
+
+AccessTraceReader::AccessTraceReader(std::string const& path) : _file(path), _valid(false) {
+    if (_file.size() < sizeof(MAGIC) or std::memcmp(_file.data(), MAGIC, sizeof(MAGIC)) != 0) return;
+    if ((_file.size() - sizeof(MAGIC)) % sizeof(std::uint64_t) != 0) return;
+    _keys = std::span<std::uint64_t const>(reinterpret_cast<std::uint64_t const*>(_file.data() + sizeof(MAGIC)),
+                                           (_file.size() - sizeof(MAGIC)) / sizeof(std::uint64_t));
+    _valid = true;
+}
+
+} // namespace Helper
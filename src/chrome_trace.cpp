@@ -0,0 +1,144 @@
+/***************************************************************************
+ *            chrome_trace.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <set>
+#include "chrome_trace.hpp"
+
+namespace Helper {
+
+namespace {
+
+//! \brief A writer appending to a buffer, which is written to the stream whenever it exceeds a chunk size
+class BufferedWriter {
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+  public:
+    BufferedWriter(std::ofstream& stream) : _stream(stream) { _buffer.reserve(CHUNK_SIZE + 4096); }
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter& operator<<(std::string_view str) { _buffer.append(str); _flush_if_full(); return *this; }
+    BufferedWriter& operator<<(char c) { _buffer.push_back(c); _flush_if_full(); return *this; }
+    BufferedWriter& operator<<(size_t n) { return *this << std::string_view(std::to_string(n)); }
+
+    //! \brief Append nanoseconds as microseconds with three decimals
+    void microseconds(std::int64_t nanoseconds) {
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(nanoseconds/1000), static_cast<long long>(nanoseconds%1000));
+        *this << std::string_view(text, static_cast<size_t>(length));
+    }
+
+    //! \brief Append a JSON string, escaping quotes, backslashes and control characters
+    void quoted(std::string_view str) {
+        _buffer.push_back('"');
+        for (char c : str) {
+            if (c == '"' or c == '\\') {
+                _buffer.push_back('\\');
+                _buffer.push_back(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                _buffer.append(escaped);
+            } else {
+                _buffer.push_back(c);
+            }
+        }
+        _buffer.push_back('"');
+        _flush_if_full();
+    }
+
+    void flush() {
+        _stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+    }
+
+  private:
+    void _flush_if_full() { if (_buffer.size() >= CHUNK_SIZE) flush(); }
+  private:
+    std::ofstream& _stream;
+    std::string _buffer;
+};
+
+} // namespace
+
+void ChromeTrace::add_zones(ZoneProfiler const& profiler) {
+    for (auto const& thread_events : profiler.events()) {
+        size_t depth = 0;
+        for (auto const& event : thread_events.events) {
+            if (event.name != nullptr) {
+                ++depth;
+                _events.push_back(Event{event.name, 'B', thread_events.thread_index, event.time, 0});
+            } else if (depth > 0) {
+                --depth;
+                _events.push_back(Event{std::string(), 'E', thread_events.thread_index, event.time, 0});
+            }
+        }
+    }
+}
+
+bool ChromeTrace::write(std::string const& path) const {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (not stream) return false;
+    std::int64_t base_time = std::numeric_limits<std::int64_t>::max();
+    std::set<size_t> thread_indices;
+    for (auto const& event : _events) {
+        base_time = std::min(base_time, event.time);
+        thread_indices.insert(event.thread_index);
+    }
+    {
+        BufferedWriter writer(stream);
+        writer << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (size_t thread_index : thread_indices) {
+            writer << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_index
+                   << ",\"args\":{\"name\":\"Thread " << thread_index << "\"}}";
+            first = false;
+        }
+        for (auto const& event : _events) {
+            writer << (first ? "\n" : ",\n") << "{\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << event.thread_index << ",\"ts\":";
+            writer.microseconds(event.time - base_time);
+            if (event.phase != 'E') {
+                writer << ",\"name\":";
+                writer.quoted(event.name);
+            }
+            if (event.phase == 'X') {
+                writer << ",\"dur\":";
+                writer.microseconds(event.duration);
+            }
+            writer << '}';
+            first = false;
+        }
+        writer << "\n]}\n";
+    }
+    stream.close();
+    return static_cast<bool>(stream);
+}
+
+} // namespace Helper
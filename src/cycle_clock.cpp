@@ -0,0 +1,83 @@
+/***************************************************************************
+ *            cycle_clock.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <thread>
+#include "cycle_clock.hpp"
+
+#if HELPER_HAS_TSC and not defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace Helper {
+
+namespace {
+
+//! \brief Whether the CPU advertises an invariant time stamp counter, in bit 8 of EDX for the extended leaf 0x80000007
+bool has_invariant_tsc() {
+#if HELPER_HAS_TSC
+#ifdef _MSC_VER
+    int registers[4];
+    __cpuid(registers, 0x80000000);
+    if (static_cast<unsigned>(registers[0]) < 0x80000007u) return false;
+    __cpuid(registers, 0x80000007);
+    return (static_cast<unsigned>(registers[3]) & (1u << 8)) != 0;
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) return false;
+    if (not __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;
+#endif
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+CycleClock::Calibration CycleClock::calibrate() {
+    Calibration result{false, 0, 0, 0};
+#if HELPER_HAS_TSC
+    if (not has_invariant_tsc()) return result;
+    auto start_time = std::chrono::steady_clock::now();
+    std::uint64_t start_ticks = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto end_time = std::chrono::steady_clock::now();
+    std::uint64_t end_ticks = __rdtsc();
+    auto elapsed = std::chrono::duration_cast<duration>(end_time-start_time).count();
+    if (end_ticks <= start_ticks or elapsed <= 0) return result;
+    double nanoseconds_per_tick = static_cast<double>(elapsed)/static_cast<double>(end_ticks-start_ticks);
+    result.invariant = true;
+    result.base_ticks = end_ticks;
+    result.base_nanoseconds = std::chrono::duration_cast<duration>(end_time.time_since_epoch()).count();
+    result.factor = static_cast<std::uint64_t>(std::llround(nanoseconds_per_tick*4294967296.0));
+#endif
+    return result;
+}
+
+} // namespace Helper
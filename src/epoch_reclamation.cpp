@@ -0,0 +1,133 @@
+/***************************************************************************
+ *            epoch_reclamation.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <limits>
+#include "epoch_reclamation.hpp"
+
+namespace Helper {
+
+namespace {
+
+//! \brief The record of the current thread, released when the thread exits
+struct ThreadRecord {
+    ~ThreadRecord() {
+        if (record != nullptr) release(record);
+    }
+    void* record = nullptr;
+    unsigned depth = 0;
+    void (*release)(void*) = nullptr;
+};
+
+thread_local ThreadRecord thread_record;
+
+} // namespace
+
+EpochDomain& EpochDomain::instance() {
+    static EpochDomain domain;
+    return domain;
+}
+
+EpochDomain::EpochDomain() : _epoch(1), _records(nullptr) { }
+
+EpochDomain::~EpochDomain() {
+    for (auto const& r : _retired) r.deleter(r.pointer);
+    Record* record = _records.load();
+    while (record != nullptr) {
+        Record* next = record->next;
+        delete record;
+        record = next;
+    }
+}
+
+EpochDomain::Guard::Guard() {
+    if (thread_record.depth++ > 0) return;
+    auto& domain = EpochDomain::instance();
+    if (thread_record.record == nullptr) {
+        thread_record.record = domain._acquire_record();
+        thread_record.release = [](void* r) {
+            auto record = static_cast<Record*>(r);
+            record->epoch.store(0, std::memory_order_release);
+            record->in_use.store(false, std::memory_order_release);
+        };
+    }
+    auto record = static_cast<Record*>(thread_record.record);
+    // Publishing an epoch that a concurrent retirement has already advanced past would let it miss this reader, hence retry
+    while (true) {
+        std::uint64_t epoch = domain._epoch.load();
+        record->epoch.store(epoch);
+        if (domain._epoch.load() == epoch) break;
+    }
+}
+
+EpochDomain::Guard::~Guard() {
+    if (--thread_record.depth > 0) return;
+    static_cast<Record*>(thread_record.record)->epoch.store(0, std::memory_order_release);
+}
+
+EpochDomain::Record* EpochDomain::_acquire_record() {
+    for (Record* record = _records.load(); record != nullptr; record = record->next) {
+        bool expected = false;
+        if (not record->in_use.load(std::memory_order_relaxed) and record->in_use.compare_exchange_strong(expected, true)) return record;
+    }
+    Record* record = new Record();
+    record->in_use.store(true);
+    record->next = _records.load();
+    while (not _records.compare_exchange_weak(record->next, record)) { }
+    return record;
+}
+
+void EpochDomain::_retire(void* pointer, void (*deleter)(void*)) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _retired.push_back({pointer, deleter, _epoch.fetch_add(1)});
+    if (_retired.size() >= RECLAIM_THRESHOLD) _reclaim();
+}
+
+void EpochDomain::reclaim() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _reclaim();
+}
+
+size_t EpochDomain::number_of_retired() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _retired.size();
+}
+
+void EpochDomain::_reclaim() {
+    std::uint64_t minimum_active = std::numeric_limits<std::uint64_t>::max();
+    for (Record* record = _records.load(); record != nullptr; record = record->next) {
+        std::uint64_t epoch = record->epoch.load();
+        if (epoch != 0) minimum_active = std::min(minimum_active, epoch);
+    }
+    // An object retired at epoch E may be held only by readers that entered at an epoch not greater than E
+    auto reclaimable = std::stable_partition(_retired.begin(), _retired.end(), [minimum_active](Retired const& r){ return r.epoch >= minimum_active; });
+    for (auto it = reclaimable; it != _retired.end(); ++it) it->deleter(it->pointer);
+    _retired.erase(reclaimable, _retired.end());
+}
+
+} // namespace Helper
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *            latency_histogram.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "macros.hpp"
+#include "latency_histogram.hpp"
+
+namespace Helper {
+
+LatencyHistogram::LatencyHistogram(std::int64_t highest_trackable_value, unsigned int significant_digits)
+    : _highest_trackable_value(highest_trackable_value), _significant_digits(significant_digits), _total_count(0),
+      _min(std::numeric_limits<std::int64_t>::max()), _max(std::numeric_limits<std::int64_t>::min()) {
+    HELPER_PRECONDITION(highest_trackable_value >= 2);
+    HELPER_PRECONDITION(significant_digits >= 1 and significant_digits <= 5);
+    // Enough linear sub-buckets for two values differing by one unit of the last significant digit to fall into different ones
+    std::uint64_t largest_value_with_single_unit_resolution = 2;
+    for (unsigned int i=0; i<significant_digits; ++i) largest_value_with_single_unit_resolution *= 10;
+    unsigned int sub_bucket_count_magnitude = static_cast<unsigned int>(std::bit_width(largest_value_with_single_unit_resolution-1));
+    _sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+    _sub_bucket_half_count = std::uint64_t(1) << _sub_bucket_half_count_magnitude;
+    _sub_bucket_mask = (std::uint64_t(1) << sub_bucket_count_magnitude) - 1;
+    _counts.assign(_index(static_cast<std::uint64_t>(highest_trackable_value)) + 1, 0);
+}
+
+LatencyHistogram& LatencyHistogram::operator+=(LatencyHistogram const& other) {
+    HELPER_PRECONDITION(_highest_trackable_value == other._highest_trackable_value and _significant_digits == other._significant_digits);
+    for (size_t i=0; i<_counts.size(); ++i) _counts[i] += other._counts[i];
+    _total_count += other._total_count;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    return *this;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(_counts.begin(), _counts.end(), 0);
+    _total_count = 0;
+    _min = std::numeric_limits<std::int64_t>::max();
+    _max = std::numeric_limits<std::int64_t>::min();
+}
+
+std::uint64_t LatencyHistogram::_value_at(size_t index) const {
+    std::uint64_t i = index;
+    std::uint64_t sub_bucket = (i & (_sub_bucket_half_count - 1)) + _sub_bucket_half_count;
+    std::uint64_t bucket = i >> _sub_bucket_half_count_magnitude;
+    if (bucket == 0) return sub_bucket - _sub_bucket_half_count;
+    return sub_bucket << (bucket - 1);
+}
+
+std::uint64_t LatencyHistogram::_highest_equivalent_at(size_t index) const {
+    std::uint64_t bucket = static_cast<std::uint64_t>(index) >> _sub_bucket_half_count_magnitude;
+    return _value_at(index) + (bucket == 0 ? 0 : (std::uint64_t(1) << (bucket - 1)) - 1);
+}
+
+double LatencyHistogram::mean() const {
+    if (_total_count == 0) return 0.0;
+    double total = 0.0;
+    for (size_t i=0; i<_counts.size(); ++i) {
+        if (_counts[i] == 0) continue;
+        double median_equivalent = (static_cast<double>(_value_at(i)) + static_cast<double>(_highest_equivalent_at(i)))/2;
+        total += median_equivalent*static_cast<double>(_counts[i]);
+    }
+    return total/static_cast<double>(_total_count);
+}
+
+std::int64_t LatencyHistogram::value_at_percentile(double percentile) const {
+    HELPER_PRECONDITION(percentile >= 0.0 and percentile <= 100.0);
+    if (_total_count == 0) return 0;
+    auto target = static_cast<std::uint64_t>(std::ceil(percentile/100.0*static_cast<double>(_total_count)));
+    if (target == 0) target = 1;
+    std::uint64_t cumulative = 0;
+    for (size_t i=0; i<_counts.size(); ++i) {
+        cumulative += _counts[i];
+        if (cumulative >= target) return std::min(static_cast<std::int64_t>(_highest_equivalent_at(i)), _max);
+    }
+    return _max;
+}
+
+LatencyPercentiles LatencyHistogram::percentiles() const {
+    LatencyPercentiles result;
+    result.p50 = value_at_percentile(50.0);
+    result.p90 = value_at_percentile(90.0);
+    result.p99 = value_at_percentile(99.0);
+    result.p999 = value_at_percentile(99.9);
+    result.max = max();
+    return result;
+}
+
+} // namespace Helper
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *            mapped_file.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <utility>
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Helper {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::string const& path) : _data(nullptr), _size(0), _mapping(nullptr) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) and size.QuadPart > 0) {
+        _mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping != nullptr) {
+            _data = static_cast<char const*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (_data != nullptr) _size = static_cast<size_t>(size.QuadPart);
+            else { CloseHandle(_mapping); _mapping = nullptr; }
+        }
+    }
+    CloseHandle(file);
+}
+
+void MappedFile::_unmap() {
+    if (_data != nullptr) UnmapViewOfFile(_data);
+    if (_mapping != nullptr) CloseHandle(_mapping);
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data,nullptr)), _size(std::exchange(other._size,0)), _mapping(std::exchange(other._mapping,nullptr)) { }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        _unmap();
+        _data = std::exchange(other._data,nullptr);
+        _size = std::exchange(other._size,0);
+        _mapping = std::exchange(other._mapping,nullptr);
+    }
+    return *this;
+}
+
+#else
+
+MappedFile::MappedFile(std::string const& path) : _data(nullptr), _size(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat status;
+    if (::fstat(fd, &status) == 0 and status.st_size > 0) {
+        auto size = static_cast<size_t>(status.st_size);
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            _data = static_cast<char const*>(address);
+            _size = size;
+        }
+    }
+    ::close(fd);
+}
+
+void MappedFile::_unmap() {
+    if (_data != nullptr) ::munmap(const_cast<char*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data,nullptr)), _size(std::exchange(other._size,0)) { }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        _unmap();
+        _data = std::exchange(other._data,nullptr);
+        _size = std::exchange(other._size,0);
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    _unmap();
+}
+
+} // namespace Helper
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *            memo.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "macros.hpp"
+#include "memo.hpp"
+
+namespace Helper {
+
+namespace {
+
+//! \brief The nodes being computed on this thread, innermost last
+thread_local std::vector<MemoNode*> computing_nodes;
+
+} // namespace
+
+size_t MemoNode::number_of_dependents() const {
+    return static_cast<size_t>(std::count_if(_dependents.begin(), _dependents.end(), [](auto const& d) { return not d.expired(); }));
+}
+
+void MemoNode::invalidate_dependents() {
+    std::vector<std::shared_ptr<MemoNode>> pending;
+    auto push_dependents = [&pending](MemoNode& node) {
+        std::erase_if(node._dependents, [](auto const& d) { return d.expired(); });
+        for (auto const& d : node._dependents) {
+            auto dependent = d.lock();
+            if (not dependent->_dirty) {
+                dependent->_dirty = true;
+                pending.push_back(std::move(dependent));
+            }
+        }
+    };
+    push_dependents(*this);
+    while (not pending.empty()) {
+        auto node = std::move(pending.back());
+        pending.pop_back();
+        push_dependents(*node);
+    }
+}
+
+void MemoNode::record_read() {
+    HELPER_ASSERT_MSG(not _computing, "Cyclic dependency between memoized values.")
+    if (computing_nodes.empty()) return;
+    MemoNode& reader = *computing_nodes.back();
+    auto self = shared_from_this();
+    if (std::find(reader._dependencies.begin(), reader._dependencies.end(), self) != reader._dependencies.end()) return;
+    reader._dependencies.push_back(self);
+    _dependents.push_back(reader.weak_from_this());
+}
+
+MemoNode::ComputationScope::ComputationScope(MemoNode& node) : _node(node) {
+    for (auto const& dependency : _node._dependencies)
+        std::erase_if(dependency->_dependents, [&node](auto const& d) { auto p = d.lock(); return p == nullptr or p.get() == &node; });
+    _node._dependencies.clear();
+    _node._computing = true;
+    computing_nodes.push_back(&_node);
+}
+
+MemoNode::ComputationScope::~ComputationScope() {
+    computing_nodes.pop_back();
+    _node._computing = false;
+}
+
+void MemoNode::ComputationScope::complete() {
+    _node._dirty = false;
+}
+
+} // namespace Helper
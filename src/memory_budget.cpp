@@ -0,0 +1,125 @@
+/***************************************************************************
+ *            memory_budget.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vector>
+#include "memory_budget.hpp"
+
+namespace Helper {
+
+MemoryBudget::Entry::~Entry() {
+    std::lock_guard<std::mutex> lock(_budget._mutex);
+    if (_listed) {
+        _budget._entries.erase(_position);
+        _budget._used -= _bytes;
+    }
+}
+
+void MemoryBudget::Entry::_charge(size_t bytes) {
+    std::lock_guard<std::mutex> lock(_budget._mutex);
+    _bytes = bytes;
+    _budget._entries.push_front(this);
+    _position = _budget._entries.begin();
+    _listed = true;
+    _budget._used += bytes;
+}
+
+void MemoryBudget::Entry::_touch() {
+    std::lock_guard<std::mutex> lock(_budget._mutex);
+    if (_listed) {
+        _budget._entries.splice(_budget._entries.begin(), _budget._entries, _position);
+    } else {
+        _budget._entries.push_front(this);
+        _position = _budget._entries.begin();
+        _listed = true;
+        _budget._used += _bytes;
+    }
+}
+
+MemoryBudget::MemoryBudget(size_t capacity) : _capacity(capacity), _used(0), _evictions(0) { }
+
+MemoryBudget& MemoryBudget::global() {
+    static MemoryBudget budget(std::numeric_limits<size_t>::max());
+    return budget;
+}
+
+size_t MemoryBudget::capacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _capacity;
+}
+
+void MemoryBudget::set_capacity(size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+    }
+    trim();
+}
+
+size_t MemoryBudget::used() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _used;
+}
+
+size_t MemoryBudget::number_of_entries() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+uint64_t MemoryBudget::number_of_evictions() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _evictions;
+}
+
+void MemoryBudget::trim() {
+    // Victims are unlisted under the budget lock, then released under their own lock only, since entries lock the budget while
+    // holding their own lock; an entry being destroyed can't be locked, but its destructor waits for the budget lock to unlist it
+    std::vector<std::shared_ptr<Entry>> victims;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        while (_used > _capacity and _entries.size() > 1) {
+            Entry* entry = _entries.back();
+            _entries.pop_back();
+            entry->_listed = false;
+            _used -= entry->_bytes;
+            if (auto locked = entry->weak_from_this().lock()) victims.push_back(std::move(locked));
+        }
+    }
+    // Released objects are destroyed after the locks, since they may own entries of this budget, whose destructor locks it
+    std::vector<std::shared_ptr<void const>> released;
+    for (auto& victim : victims) {
+        std::lock_guard<std::mutex> entry_lock(victim->_mutex);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (victim->_listed) continue;
+        if (auto object = victim->_release()) {
+            released.push_back(std::move(object));
+            ++_evictions;
+        }
+    }
+}
+
+} // namespace Helper
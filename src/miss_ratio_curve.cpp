@@ -0,0 +1,117 @@
+/***************************************************************************
+ *            miss_ratio_curve.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include "macros.hpp"
+#include "miss_ratio_curve.hpp"
+
+namespace Helper {
+
+namespace {
+
+//! \brief A Fenwick tree of counts over access times, marking the last access to each key
+class FenwickTree {
+  public:
+    FenwickTree(size_t size) : _tree(size+1,0) { }
+    void add(size_t index, int delta) {
+        for (size_t i = index+1; i < _tree.size(); i += i & (~i+1)) _tree[i] += delta;
+    }
+    //! \brief The sum of counts with index lower than \a index
+    size_t prefix_sum(size_t index) const {
+        long result = 0;
+        for (size_t i = index; i > 0; i -= i & (~i+1)) result += _tree[i];
+        return static_cast<size_t>(result);
+    }
+  private:
+    std::vector<long> _tree;
+};
+
+constexpr std::uint64_t SAMPLING_MODULUS = 1ull << 24;
+
+} // namespace
+
+MissRatioCurve::MissRatioCurve(std::span<std::uint64_t const> keys, double sampling_rate)
+    : _sampling_rate(sampling_rate), _number_of_accesses(keys.size()), _number_of_sampled_accesses(0), _number_of_distinct_keys(0), _total(0) {
+    HELPER_PRECONDITION(sampling_rate > 0 and sampling_rate <= 1);
+    auto threshold = static_cast<std::uint64_t>(std::ceil(sampling_rate*static_cast<double>(SAMPLING_MODULUS)));
+    auto is_sampled = [threshold](std::uint64_t key) { return key % SAMPLING_MODULUS < threshold; };
+
+    for (auto key : keys) if (is_sampled(key)) ++_number_of_sampled_accesses;
+
+    FenwickTree last_accesses(_number_of_sampled_accesses);
+    std::unordered_map<std::uint64_t,size_t> last_access_times;
+    std::vector<double> hits;
+    size_t time = 0;
+    for (auto key : keys) {
+        if (not is_sampled(key)) continue;
+        auto [it, inserted] = last_access_times.try_emplace(key, time);
+        if (not inserted) {
+            size_t distance = last_accesses.prefix_sum(time) - last_accesses.prefix_sum(it->second+1);
+            if (distance >= hits.size()) hits.resize(distance+1,0);
+            hits[distance] += 1;
+            last_accesses.add(it->second,-1);
+            it->second = time;
+        }
+        last_accesses.add(time,1);
+        ++time;
+    }
+
+    _number_of_distinct_keys = static_cast<size_t>(std::round(static_cast<double>(last_access_times.size())/sampling_rate));
+    _total = static_cast<double>(_number_of_sampled_accesses);
+    // Correct the hits at the shortest distances by the difference between the sampled and expected accesses, as in SHARDS-adj;
+    // an excess, typically due to sampling a very hot key, may exceed the first bucket and is then removed from the following ones
+    double excess = _total - sampling_rate*static_cast<double>(_number_of_accesses);
+    if (excess < 0 and not hits.empty()) {
+        hits[0] -= excess;
+        _total -= excess;
+    }
+    for (size_t d=0; excess > 0 and d<hits.size(); ++d) {
+        double removed = std::min(excess,hits[d]);
+        hits[d] -= removed;
+        _total -= removed;
+        excess -= removed;
+    }
+    _cumulative_hits.resize(hits.size());
+    double sum = 0;
+    for (size_t d=0; d<hits.size(); ++d) {
+        sum += hits[d];
+        _cumulative_hits[d] = sum;
+    }
+}
+
+double MissRatioCurve::miss_ratio(size_t cache_size) const {
+    if (_total <= 0 or cache_size == 0) return 1.0;
+    if (_cumulative_hits.empty()) return 1.0;
+    auto limit = static_cast<size_t>(std::ceil(static_cast<double>(cache_size)*_sampling_rate));
+    double hits = _cumulative_hits[std::min(limit,_cumulative_hits.size())-1];
+    return std::clamp(1.0 - hits/_total, 0.0, 1.0);
+}
+
+} // namespace Helper
@@ -0,0 +1,183 @@
+/***************************************************************************
+ *            performance_counters.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <iomanip>
+#include "performance_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Helper {
+
+namespace {
+
+constexpr PerformanceEvent ALL_EVENTS[NUMBER_OF_PERFORMANCE_EVENTS] = {
+    PerformanceEvent::CYCLES, PerformanceEvent::INSTRUCTIONS, PerformanceEvent::CACHE_MISSES, PerformanceEvent::BRANCH_MISSES,
+    PerformanceEvent::TASK_CLOCK, PerformanceEvent::PAGE_FAULTS, PerformanceEvent::CONTEXT_SWITCHES
+};
+
+#ifdef __linux__
+
+//! \brief The type and the configuration of \a event for perf_event_open
+std::pair<std::uint32_t, std::uint64_t> perf_type_and_config(PerformanceEvent event) {
+    switch (event) {
+        case PerformanceEvent::CYCLES: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+        case PerformanceEvent::INSTRUCTIONS: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+        case PerformanceEvent::CACHE_MISSES: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        case PerformanceEvent::BRANCH_MISSES: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+        case PerformanceEvent::TASK_CLOCK: return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK};
+        case PerformanceEvent::PAGE_FAULTS: return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+        case PerformanceEvent::CONTEXT_SWITCHES: return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES};
+        default: return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_DUMMY};
+    }
+}
+
+//! \brief Whether \a event is counted by the processor
+bool is_hardware(PerformanceEvent event) {
+    return perf_type_and_config(event).first == PERF_TYPE_HARDWARE;
+}
+
+//! \brief Open a counter of \a event for the calling thread, in the group of \a group_descriptor unless negative, excluding
+//! what happens in the kernel if \a user_only
+int open_counter(PerformanceEvent event, int group_descriptor, bool user_only) {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    auto [type, config] = perf_type_and_config(event);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.exclude_kernel = user_only ? 1 : 0;
+    attributes.exclude_hv = 1;
+    attributes.read_format = (group_descriptor < 0 and not is_hardware(event) ? 0 : PERF_FORMAT_GROUP) | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, group_descriptor, PERF_FLAG_FD_CLOEXEC));
+}
+
+#endif
+
+} // namespace
+
+char const* name(PerformanceEvent event) {
+    switch (event) {
+        case PerformanceEvent::CYCLES: return "cycles";
+        case PerformanceEvent::INSTRUCTIONS: return "instructions";
+        case PerformanceEvent::CACHE_MISSES: return "cache misses";
+        case PerformanceEvent::BRANCH_MISSES: return "branch misses";
+        case PerformanceEvent::TASK_CLOCK: return "task clock";
+        case PerformanceEvent::PAGE_FAULTS: return "page faults";
+        case PerformanceEvent::CONTEXT_SWITCHES: return "context switches";
+        default: return "unknown";
+    }
+}
+
+PerformanceCounters::PerformanceCounters() : _group_size(0) {
+    _slots.fill(-1);
+#ifdef __linux__
+    // Hardware events form a group, while software events are opened on their own, since some of them do not count as
+    // members of a group led by another software event
+    for (PerformanceEvent event : ALL_EVENTS) {
+        bool grouped = is_hardware(event);
+        int group_descriptor = grouped and _group_size > 0 ? _descriptors.front() : -1;
+        // Hardware events are counted in user space only, which unprivileged processes are usually restricted to; software
+        // events are counted in the kernel too, where context switches happen, and fall back to user space if forbidden,
+        // except for context switches, which would never be counted
+        int descriptor = open_counter(event, group_descriptor, grouped);
+        if (descriptor < 0 and not grouped and event != PerformanceEvent::CONTEXT_SWITCHES)
+            descriptor = open_counter(event, group_descriptor, true);
+        if (descriptor < 0) continue;
+        _slots[static_cast<size_t>(event)] = static_cast<int>(_descriptors.size());
+        _descriptors.push_back(descriptor);
+        if (grouped) ++_group_size;
+    }
+#endif
+    restart();
+}
+
+PerformanceCounters::~PerformanceCounters() {
+#ifdef __linux__
+    // Members are closed before their leader
+    for (auto it = _descriptors.rbegin(); it != _descriptors.rend(); ++it) close(*it);
+#endif
+}
+
+bool PerformanceCounters::has_hardware_events() const {
+    return is_available(PerformanceEvent::CYCLES) or is_available(PerformanceEvent::INSTRUCTIONS)
+        or is_available(PerformanceEvent::CACHE_MISSES) or is_available(PerformanceEvent::BRANCH_MISSES);
+}
+
+std::uint64_t PerformanceCounters::count(PerformanceEvent event) const {
+    int slot = _slots[static_cast<size_t>(event)];
+    if (slot < 0) return 0;
+    auto index = static_cast<size_t>(slot);
+    double difference = _clicked[index] - _initial[index];
+    return difference > 0.0 ? static_cast<std::uint64_t>(difference + 0.5) : 0;
+}
+
+PerformanceCounters& PerformanceCounters::restart() {
+    _initial = _read();
+    _clicked = _initial;
+    return *this;
+}
+
+PerformanceCounters& PerformanceCounters::click() {
+    _clicked = _read();
+    return *this;
+}
+
+std::vector<double> PerformanceCounters::_read() const {
+    std::vector<double> result(_descriptors.size(), 0.0);
+#ifdef __linux__
+    // A group reads as its number of values, the times enabled and running, then the values; a single counter reads as its
+    // value, then the times
+    auto read_values = [&result](int descriptor, size_t first, size_t number, bool group) {
+        std::vector<std::uint64_t> buffer(3 + (group ? number : 0), 0);
+        auto size = static_cast<ssize_t>(buffer.size()*sizeof(std::uint64_t));
+        if (read(descriptor, buffer.data(), static_cast<size_t>(size)) != size) return;
+        std::uint64_t time_enabled = buffer[1], time_running = buffer[2];
+        double scaling = (time_running > 0 and time_running < time_enabled) ? static_cast<double>(time_enabled)/static_cast<double>(time_running) : 1.0;
+        for (size_t i=0; i<number; ++i) result[first+i] = static_cast<double>(buffer[group ? 3+i : 0])*scaling;
+    };
+    if (_group_size > 0) read_values(_descriptors.front(), 0, _group_size, true);
+    for (size_t i=_group_size; i<_descriptors.size(); ++i) read_values(_descriptors[i], i, 1, false);
+#endif
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& os, PerformanceCounters const& counters) {
+    os << "{";
+    bool first = true;
+    for (PerformanceEvent event : ALL_EVENTS) {
+        if (not counters.is_available(event)) continue;
+        os << (first ? "" : ", ") << name(event) << ":" << counters.count(event);
+        first = false;
+    }
+    return os << "}";
+}
+
+} // namespace Helper
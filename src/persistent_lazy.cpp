@@ -0,0 +1,71 @@
+/***************************************************************************
+ *            persistent_lazy.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include "persistent_lazy.hpp"
+
+namespace Helper {
+
+std::string MemoKey::file_name() const {
+    // FNV-1a, whose collisions are harmless since the whole key is checked on load
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : _bytes) hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.memo", static_cast<unsigned long long>(hash));
+    return name;
+}
+
+std::string default_memo_directory() {
+#ifdef _MSC_VER
+#pragma warning(suppress: 4996)
+#endif
+    char const* directory = std::getenv("HELPER_MEMO_DIRECTORY");
+    if (directory != nullptr) return directory;
+    return (std::filesystem::temp_directory_path() / "helper_memo").string();
+}
+
+std::string memo_path(std::string const& directory, MemoKey const& key) {
+    return (std::filesystem::path(directory) / key.file_name()).string();
+}
+
+bool store_memo(std::string const& directory, MemoKey const& key, std::string_view value) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return false;
+    SnapshotWriter writer(0);
+    writer.begin_record(0, -1);
+    writer.buffer().append(key.bytes());
+    writer.end_field();
+    writer.buffer().append(value);
+    writer.end_field();
+    return writer.write(memo_path(directory, key));
+}
+
+} // namespace Helper
@@ -0,0 +1,202 @@
+/***************************************************************************
+ *            profile_zone.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <iomanip>
+#include <thread>
+#include "profile_zone.hpp"
+
+namespace Helper {
+
+struct ZoneProfiler::Block {
+    static constexpr size_t CAPACITY = 1024;
+    ZoneEvent events[CAPACITY];
+    std::atomic<size_t> size = 0;
+    std::atomic<Block*> next = nullptr;
+};
+
+struct ZoneProfiler::Buffer {
+    Buffer(std::thread::id t, size_t i) : thread(t), index(i), head(new Block), tail(head) { }
+    ~Buffer() { _delete_from(head); }
+    //! \brief Drop all the events, keeping the first block
+    void clear() {
+        _delete_from(head->next.load(std::memory_order_acquire));
+        head->next.store(nullptr, std::memory_order_relaxed);
+        head->size.store(0, std::memory_order_release);
+        tail = head;
+    }
+    std::thread::id const thread;
+    size_t const index;
+    Block* const head;
+    //! \brief The block being appended to, accessed by the owning thread only
+    Block* tail;
+  private:
+    static void _delete_from(Block* block) {
+        while (block != nullptr) {
+            Block* next = block->next.load(std::memory_order_acquire);
+            delete block;
+            block = next;
+        }
+    }
+};
+
+namespace {
+
+//! \brief The source of identifiers of profilers, which unlike addresses are never reused
+std::atomic<std::uint64_t> next_profiler_identifier = 1;
+
+//! \brief The buffer of the current thread for the profiler last used by the thread
+struct CachedBuffer {
+    std::uint64_t profiler_identifier = 0;
+    void* buffer = nullptr;
+};
+thread_local CachedBuffer cached_buffer;
+
+void print(std::ostream& os, ZoneNode const& node, size_t depth) {
+    os << std::string(2*depth, ' ') << std::left << std::setw(static_cast<int>(40-std::min<size_t>(2*depth,39))) << node.name << std::right
+       << std::setw(10) << node.calls << " calls" << std::fixed << std::setprecision(3)
+       << std::setw(14) << static_cast<double>(node.inclusive_time)/1e6 << " ms incl."
+       << std::setw(14) << static_cast<double>(node.exclusive_time)/1e6 << " ms excl.\n";
+    for (auto const& child : node.children) print(os, child, depth+1);
+}
+
+} // namespace
+
+ZoneNode const* ZoneNode::child(std::string const& child_name) const {
+    for (auto const& c : children)
+        if (c.name == child_name) return &c;
+    return nullptr;
+}
+
+std::ostream& operator<<(std::ostream& os, ZoneNode const& node) {
+    if (node.name.empty()) {
+        for (auto const& child : node.children) print(os, child, 0);
+    } else {
+        print(os, node, 0);
+    }
+    return os;
+}
+
+ZoneProfiler& ZoneProfiler::instance() {
+    static ZoneProfiler profiler;
+    return profiler;
+}
+
+ZoneProfiler::ZoneProfiler() : _identifier(next_profiler_identifier.fetch_add(1, std::memory_order_relaxed)) { }
+
+ZoneProfiler::~ZoneProfiler() = default;
+
+void ZoneProfiler::_record(char const* name) {
+    std::int64_t time = CycleClock::now().time_since_epoch().count();
+    Buffer& buffer = _buffer();
+    Block* block = buffer.tail;
+    size_t size = block->size.load(std::memory_order_relaxed);
+    if (size == Block::CAPACITY) {
+        Block* next = new Block;
+        block->next.store(next, std::memory_order_release);
+        buffer.tail = block = next;
+        size = 0;
+    }
+    block->events[size] = ZoneEvent{name, time};
+    block->size.store(size+1, std::memory_order_release);
+}
+
+ZoneProfiler::Buffer& ZoneProfiler::_buffer() {
+    if (cached_buffer.profiler_identifier == _identifier) return *static_cast<Buffer*>(cached_buffer.buffer);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto thread = std::this_thread::get_id();
+    Buffer* result = nullptr;
+    for (auto const& buffer : _buffers)
+        if (buffer->thread == thread) result = buffer.get();
+    if (result == nullptr) {
+        _buffers.push_back(std::make_unique<Buffer>(thread, _buffers.size()));
+        result = _buffers.back().get();
+    }
+    cached_buffer = CachedBuffer{_identifier, result};
+    return *result;
+}
+
+size_t ZoneProfiler::thread_index() {
+    return _buffer().index;
+}
+
+std::vector<ThreadZoneEvents> ZoneProfiler::events() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<ThreadZoneEvents> result;
+    for (auto const& buffer : _buffers) {
+        ThreadZoneEvents thread_events{buffer->index, {}};
+        for (Block const* block = buffer->head; block != nullptr; block = block->next.load(std::memory_order_acquire)) {
+            size_t size = block->size.load(std::memory_order_acquire);
+            thread_events.events.insert(thread_events.events.end(), block->events, block->events+size);
+        }
+        if (not thread_events.events.empty()) result.push_back(std::move(thread_events));
+    }
+    return result;
+}
+
+ZoneNode ZoneProfiler::call_tree() const {
+    struct OpenZone {
+        ZoneNode* node;
+        std::int64_t enter_time;
+        std::int64_t children_time;
+    };
+    ZoneNode root;
+    // Nodes on the stack stay valid, since children are only added to the innermost open zone
+    for (auto const& thread_events : events()) {
+        std::vector<OpenZone> stack;
+        for (auto const& event : thread_events.events) {
+            if (event.name != nullptr) {
+                ZoneNode& parent = stack.empty() ? root : *stack.back().node;
+                ZoneNode* node = nullptr;
+                for (auto& child : parent.children)
+                    if (child.name == event.name) node = &child;
+                if (node == nullptr) {
+                    parent.children.push_back(ZoneNode{event.name, 0, 0, 0, {}});
+                    node = &parent.children.back();
+                }
+                stack.push_back(OpenZone{node, event.time, 0});
+            } else if (not stack.empty()) {
+                OpenZone zone = stack.back();
+                stack.pop_back();
+                std::int64_t elapsed = event.time - zone.enter_time;
+                ++zone.node->calls;
+                zone.node->inclusive_time += elapsed;
+                zone.node->exclusive_time += elapsed - zone.children_time;
+                if (not stack.empty()) stack.back().children_time += elapsed;
+            }
+        }
+    }
+    return root;
+}
+
+void ZoneProfiler::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& buffer : _buffers) buffer->clear();
+}
+
+} // namespace Helper
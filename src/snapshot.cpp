@@ -0,0 +1,180 @@
+/***************************************************************************
+ *            snapshot.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include "snapshot.hpp"
+
+namespace Helper {
+
+namespace {
+
+constexpr char MAGIC[8] = {'H','L','P','S','N','A','P','\n'};
+constexpr std::uint32_t FORMAT_VERSION = 2;
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 2*sizeof(std::uint32_t) + sizeof(std::uint64_t);
+constexpr size_t RECORD_PREFIX_SIZE = sizeof(std::uint64_t) + sizeof(std::int64_t);
+
+template<class T> void write_at(std::string& buffer, size_t position, T const& value) {
+    std::memcpy(buffer.data()+position, &value, sizeof(T));
+}
+
+template<class T> void append(std::string& buffer, T const& value) {
+    buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+//! \brief Read a \a T at \a position if within \a size, advancing the position
+template<class T> bool read(char const* data, size_t size, size_t& position, T& value) {
+    if (size - position < sizeof(T)) return false;
+    std::memcpy(&value, data+position, sizeof(T));
+    position += sizeof(T);
+    return true;
+}
+
+//! \brief A word-at-a-time hash for detecting corruption, not meant to resist tampering
+std::uint64_t checksum(char const* data, size_t size) {
+    std::uint64_t result = 0x9E3779B97F4A7C15ull ^ size;
+    size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data+i, sizeof(word));
+        result = (result ^ word) * 0xFF51AFD7ED558CCDull;
+        result ^= result >> 32;
+    }
+    for (; i < size; ++i) {
+        result = (result ^ static_cast<unsigned char>(data[i])) * 0xFF51AFD7ED558CCDull;
+        result ^= result >> 32;
+    }
+    return result;
+}
+
+//! \brief A temporary path next to \a path, unique across threads and processes, so that concurrent writers of the same
+//! snapshot never write the same temporary file and each rename publishes a complete one
+std::string unique_temporary_path(std::string const& path) {
+    static std::atomic<std::uint64_t> counter = 0;
+    static std::uint64_t const process_seed = (std::uint64_t(std::random_device()()) << 32) | std::random_device()();
+    std::uint64_t suffix = process_seed ^ (counter.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ull);
+    char text[24];
+    std::snprintf(text, sizeof(text), ".%016llx.tmp", static_cast<unsigned long long>(suffix));
+    return path + text;
+}
+
+} // namespace
+
+SnapshotWriter::SnapshotWriter(std::uint32_t version) : _buffer(HEADER_SIZE, '\0'), _field_start(0), _number_of_fields(0), _number_of_records(0) {
+    std::memcpy(_buffer.data(), MAGIC, sizeof(MAGIC));
+    write_at(_buffer, sizeof(MAGIC), FORMAT_VERSION);
+    write_at(_buffer, sizeof(MAGIC)+sizeof(std::uint32_t), version);
+}
+
+void SnapshotWriter::begin_record(std::uint64_t weight, std::int64_t expiry) {
+    HELPER_PRECONDITION(_number_of_fields == 0);
+    append(_buffer, weight);
+    append(_buffer, expiry);
+    append(_buffer, std::uint64_t(0));
+    _field_start = _buffer.size();
+}
+
+void SnapshotWriter::end_field() {
+    write_at(_buffer, _field_start-sizeof(std::uint64_t), std::uint64_t(_buffer.size()-_field_start));
+    if (++_number_of_fields == 2) {
+        _number_of_fields = 0;
+        ++_number_of_records;
+    } else {
+        append(_buffer, std::uint64_t(0));
+        _field_start = _buffer.size();
+    }
+}
+
+bool SnapshotWriter::write(std::string const& path) {
+    HELPER_PRECONDITION(_number_of_fields == 0);
+    write_at(_buffer, sizeof(MAGIC)+2*sizeof(std::uint32_t), std::uint64_t(_number_of_records));
+    std::uint64_t sum = checksum(_buffer.data(), _buffer.size());
+    std::string temporary_path = unique_temporary_path(path);
+    {
+        std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+        stream.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        stream.write(reinterpret_cast<char const*>(&sum), sizeof(sum));
+        stream.close();
+        if (not stream) {
+            std::error_code ignored;
+            std::filesystem::remove(temporary_path, ignored);
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary_path, ignored);
+    }
+    return not error;
+}
+
+SnapshotReader::SnapshotReader(std::string const& path, std::uint32_t version) : _file(path), _valid(false) {
+    _valid = _parse(version);
+    if (not _valid) _records.clear();
+}
+
+bool SnapshotReader::_parse(std::uint32_t version) {
+    char const* data = _file.data();
+    size_t size = _file.size();
+    if (size < HEADER_SIZE + sizeof(std::uint64_t)) return false;
+    size -= sizeof(std::uint64_t);
+    std::uint64_t sum;
+    std::memcpy(&sum, data+size, sizeof(sum));
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) return false;
+    size_t position = sizeof(MAGIC);
+    std::uint32_t format_version, user_version;
+    std::uint64_t number_of_records;
+    read(data, size, position, format_version);
+    read(data, size, position, user_version);
+    read(data, size, position, number_of_records);
+    if (format_version != FORMAT_VERSION or user_version != version) return false;
+    if (checksum(data, size) != sum) return false;
+    if (number_of_records > (size - position) / (RECORD_PREFIX_SIZE + 2*sizeof(std::uint64_t))) return false;
+    _records.reserve(static_cast<size_t>(number_of_records));
+    for (std::uint64_t i = 0; i < number_of_records; ++i) {
+        SnapshotRecord record;
+        std::uint64_t label_size, value_size;
+        if (not read(data, size, position, record.weight)) return false;
+        if (not read(data, size, position, record.expiry)) return false;
+        if (not read(data, size, position, label_size) or label_size > size - position) return false;
+        record.label = std::string_view(data+position, static_cast<size_t>(label_size));
+        position += static_cast<size_t>(label_size);
+        if (not read(data, size, position, value_size) or value_size > size - position) return false;
+        record.value = std::string_view(data+position, static_cast<size_t>(value_size));
+        position += static_cast<size_t>(value_size);
+        _records.push_back(record);
+    }
+    return position == size;
+}
+
+} // namespace Helper
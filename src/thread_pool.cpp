@@ -0,0 +1,85 @@
+/***************************************************************************
+ *            thread_pool.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "macros.hpp"
+#include "thread_pool.hpp"
+
+namespace Helper {
+
+ThreadPool::ThreadPool(size_t num_threads) : _stopping(false) {
+    HELPER_PRECONDITION(num_threads > 0);
+    _threads.reserve(num_threads);
+    for (size_t i=0; i<num_threads; ++i) _threads.emplace_back([this]{ _work(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads) thread.join();
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(),1u));
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        HELPER_PRECONDITION(not _stopping);
+        _tasks.push_back(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+size_t ThreadPool::queue_size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tasks.size();
+}
+
+void ThreadPool::_work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]{ return _stopping or not _tasks.empty(); });
+            if (_tasks.empty()) return;
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        try {
+            task();
+        } catch (...) { }
+    }
+}
+
+} // namespace Helper
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *            test_chrome_trace.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "chrome_trace.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+using namespace std::chrono_literals;
+
+size_t occurrences(std::string const& text, std::string const& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos+1)) ++count;
+    return count;
+}
+
+class TestChromeTrace {
+  public:
+    TestChromeTrace() : _path((std::filesystem::temp_directory_path() / "helper_test_chrome_trace.json").string()) { }
+    ~TestChromeTrace() { std::filesystem::remove(_path); }
+
+    void test_zones() {
+        ZoneProfiler profiler;
+        profiler.exit();
+        profiler.enter("outer");
+        profiler.enter("inner \"quoted\"");
+        profiler.exit();
+        profiler.exit();
+        std::thread([&profiler]{ profiler.enter("worker"); profiler.exit(); }).join();
+
+        ChromeTrace trace;
+        trace.add_zones(profiler);
+        HELPER_TEST_EQUALS(trace.number_of_events(),6);
+        HELPER_TEST_ASSERT(trace.write(_path));
+        auto text = read();
+        HELPER_TEST_PRINT(text)
+        HELPER_TEST_EQUALS(occurrences(text,"\"ph\":\"B\""),3);
+        HELPER_TEST_EQUALS(occurrences(text,"\"ph\":\"E\""),3);
+        HELPER_TEST_EQUALS(occurrences(text,"\"ph\":\"M\""),2);
+        HELPER_TEST_EQUALS(occurrences(text,"\"tid\":1"),3);
+        HELPER_TEST_ASSERT(text.find("\"name\":\"inner \\\"quoted\\\"\"") != std::string::npos);
+        HELPER_TEST_EQUALS(std::count(text.begin(),text.end(),'{'),std::count(text.begin(),text.end(),'}'));
+        HELPER_TEST_ASSERT(text.find("\"ts\":0.000") != std::string::npos);
+    }
+
+    void test_intervals() {
+        ChromeTrace trace;
+        Stopwatch<Microseconds> sw;
+        CycleStopwatch<Microseconds> csw;
+        std::this_thread::sleep_for(2ms);
+        sw.click();
+        csw.click();
+        trace.add_interval("system", sw, 0);
+        trace.add_interval("cycle", csw, 0);
+        HELPER_TEST_ASSERT(trace.write(_path));
+        auto text = read();
+        HELPER_TEST_PRINT(text)
+        HELPER_TEST_EQUALS(occurrences(text,"\"ph\":\"X\""),2);
+        HELPER_TEST_EQUALS(occurrences(text,"\"dur\":"),2);
+        HELPER_TEST_ASSERT(text.find("\"dur\":0.") == std::string::npos);
+    }
+
+    void test_large() {
+        ZoneProfiler profiler;
+        for (size_t i=0; i<100000; ++i) { profiler.enter("zone"); profiler.exit(); }
+        ChromeTrace trace;
+        trace.add_zones(profiler);
+        HELPER_TEST_ASSERT(trace.write(_path));
+        auto text = read();
+        HELPER_TEST_EQUALS(occurrences(text,"\"ph\":\"B\""),100000);
+        HELPER_TEST_ASSERT(text.ends_with("]}\n"));
+    }
+
+    void test_unwritable() {
+        ChromeTrace trace;
+        HELPER_TEST_ASSERT(not trace.write((std::filesystem::temp_directory_path() / "missing_directory" / "trace.json").string()));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_zones());
+        HELPER_TEST_CALL(test_intervals());
+        HELPER_TEST_CALL(test_large());
+        HELPER_TEST_CALL(test_unwritable());
+    }
+
+  private:
+    std::string read() const {
+        std::ifstream stream(_path, std::ios::binary);
+        std::stringstream ss;
+        ss << stream.rdbuf();
+        return ss.str();
+    }
+  private:
+    std::string _path;
+};
+
+int main() {
+    TestChromeTrace().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,174 @@
+/***************************************************************************
+ *            test_concurrent_lru_cache.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "string.hpp"
+#include "concurrent_lru_cache.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+using CacheType = ConcurrentLRUCache<String,int>;
+
+class TestConcurrentLRUCache {
+  public:
+
+    void test_construct() {
+        HELPER_TEST_FAIL(CacheType(0));
+        HELPER_TEST_FAIL(CacheType(4,0));
+        CacheType cache(10,4);
+        HELPER_TEST_EQUALS(cache.current_size(),0);
+        HELPER_TEST_EQUALS(cache.maximum_size(),10);
+        HELPER_TEST_EQUALS(cache.number_of_shards(),4);
+        HELPER_TEST_EQUALS(cache.shard_maximum_size(),3);
+    }
+
+    void test_put_get() {
+        CacheType cache(8,2);
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_FAIL(cache.get("first"));
+        cache.put("first",42);
+        HELPER_TEST_ASSERT(cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.get("first"),42);
+        HELPER_TEST_FAIL(cache.put("first",10));
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+    }
+
+    void test_try_get_emplace() {
+        CacheType cache(8,2);
+        HELPER_TEST_ASSERT(not cache.try_get("first").has_value());
+        cache.emplace("first",42);
+        HELPER_TEST_EQUALS(cache.try_get("first").value(),42);
+    }
+
+    void test_many() {
+        CacheType cache(64,4);
+        std::vector<String> labels = {"a","b","c","d","e","f"};
+        std::vector<int> values = {1,2,3,4,5,6};
+        cache.put_many(std::span<String const>(labels).subspan(0,4),std::span<int const>(values).subspan(0,4));
+        HELPER_TEST_EQUALS(cache.current_size(),4);
+        auto batch = cache.get_many(labels);
+        HELPER_TEST_EQUALS(batch.values.size(),6);
+        for (size_t i=0; i<4; ++i) HELPER_TEST_EQUALS(batch.values[i].value(),values[i]);
+        HELPER_TEST_EQUALS(batch.misses.size(),2);
+        HELPER_TEST_EQUALS(batch.misses[0],4);
+        HELPER_TEST_EQUALS(batch.misses[1],5);
+        HELPER_TEST_FAIL(cache.put_many(labels,std::span<int const>(values).subspan(0,5)));
+    }
+
+    void test_shard_sizes() {
+        CacheType cache(64,4);
+        for (int i=0; i<40; ++i) cache.put(to_string(i),i);
+        auto sizes = cache.shard_sizes();
+        HELPER_TEST_EQUALS(sizes.size(),4);
+        size_t total = 0;
+        for (auto s : sizes) {
+            HELPER_TEST_ASSERT(s <= cache.shard_maximum_size());
+            total += s;
+        }
+        HELPER_TEST_EQUALS(total,cache.current_size());
+    }
+
+    void test_eviction() {
+        CacheType cache(8,2);
+        for (int i=0; i<100; ++i) cache.put(to_string(i),i);
+        HELPER_TEST_EQUALS(cache.current_size(),8);
+        HELPER_TEST_ASSERT(cache.has_label("99"));
+    }
+
+    void test_multiple_threads() {
+        size_t const num_threads = 8;
+        size_t const num_labels = 1000;
+        ConcurrentLRUCache<size_t,size_t> cache(4*num_threads*num_labels,8);
+        std::vector<std::thread> threads;
+        std::atomic<size_t> mismatches = 0;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&cache,&mismatches,t,num_labels]{
+                for (size_t i=0; i<num_labels; ++i) cache.put(t*num_labels+i,i);
+                for (size_t i=0; i<num_labels; ++i)
+                    if (cache.has_label(t*num_labels+i) and cache.get(t*num_labels+i) != i) ++mismatches;
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(mismatches,0);
+        HELPER_TEST_EQUALS(cache.current_size(),num_threads*num_labels);
+    }
+
+    void test_get_or_compute_single_flight() {
+        size_t const num_threads = 8;
+        CacheType cache(16,4);
+        std::atomic<size_t> calls = 0;
+        std::atomic<size_t> mismatches = 0;
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&cache,&calls,&mismatches]{
+                auto val = cache.get_or_compute("first",[&calls]{
+                    ++calls;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    return 42;
+                });
+                if (val != 42) ++mismatches;
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(calls,1);
+        HELPER_TEST_EQUALS(mismatches,0);
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+        HELPER_TEST_EQUALS(cache.get("first"),42);
+    }
+
+    void test_get_or_compute_failure() {
+        CacheType cache(16,4);
+        HELPER_TEST_FAIL(cache.get_or_compute("first",[]() -> int { throw std::runtime_error("factory failure"); }));
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.get_or_compute("first",[]{ return 42; }),42);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_construct());
+        HELPER_TEST_CALL(test_put_get());
+        HELPER_TEST_CALL(test_try_get_emplace());
+        HELPER_TEST_CALL(test_many());
+        HELPER_TEST_CALL(test_shard_sizes());
+        HELPER_TEST_CALL(test_eviction());
+        HELPER_TEST_CALL(test_multiple_threads());
+        HELPER_TEST_CALL(test_get_or_compute_single_flight());
+        HELPER_TEST_CALL(test_get_or_compute_failure());
+    }
+
+};
+
+int main() {
+    TestConcurrentLRUCache().test();
+    return HELPER_TEST_FAILURES;
+}
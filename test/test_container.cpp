@@ -26,6 +26,9 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <string_view>
+
+#include "string.hpp"
 #include "container.hpp"
 
 #include "test.hpp"
@@ -41,11 +44,28 @@ class TestContainer {
         HELPER_TEST_EQUALS(im.get(2),20);
     }
 
+    void test_map_heterogeneous_lookup() {
+        Map<String,int,std::less<>> m = {{"first",1},{"second",2}};
+        std::string_view view = "second";
+        HELPER_TEST_ASSERT(m.has_key(view));
+        HELPER_TEST_ASSERT(not m.has_key("third"));
+        HELPER_TEST_EQUALS(m.get(view),2);
+        HELPER_TEST_FAIL(m.get("third"));
+        m.value("first") = 10;
+        HELPER_TEST_EQUALS(m.get(String("first")),10);
+    }
+
     void test_map_convert() {
         Map<int,int> im = {{1,10},{2,20}};
 
         Map<int,double> dm(im);
         HELPER_TEST_ASSERT(dm.at(1) == im.at(1) and dm.at(2) == im.at(2));
+
+        auto size_of = [](std::map<int,int> const& m) { return m.size(); };
+        HELPER_TEST_EQUALS(size_of(im),2);
+        Map<int,int,std::less<>> tm(im);
+        Map<int,int> back(tm);
+        HELPER_TEST_EQUALS(size_of(back),2);
     }
 
     void test_map_restrict_keys() {
@@ -65,6 +85,7 @@ class TestContainer {
 
     void test() {
         HELPER_TEST_CALL(test_map_get());
+        HELPER_TEST_CALL(test_map_heterogeneous_lookup());
         HELPER_TEST_CALL(test_map_convert());
         HELPER_TEST_CALL(test_map_restrict_keys());
         HELPER_TEST_CALL(test_make_list_of_set());
@@ -0,0 +1,145 @@
+/***************************************************************************
+ *            test_eviction_policy.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <iostream>
+
+#include "lru_cache.hpp"
+#include "eviction_policy.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+class TestEvictionPolicy {
+  public:
+
+    //! \brief Check that the cache stays within bounds and consistent over a mixed sequence of accesses
+    template<class P> void test_consistency() {
+        LRUCache<size_t,size_t,P> cache(20);
+        for (size_t i=0; i<1000; ++i) {
+            size_t label = (i*7919)%(i%3 == 0 ? 15 : 60);
+            if (cache.has_label(label)) HELPER_TEST_EQUALS(cache.get(label),label)
+            else cache.put(label,label);
+            HELPER_TEST_ASSERT(cache.current_size() <= 20);
+        }
+        HELPER_TEST_EQUALS(cache.current_size(),20);
+    }
+
+    //! \brief Count the hot labels surviving a scan over cold labels, after the hot labels have been hit repeatedly among other traffic
+    template<class P> size_t hot_labels_after_scan() {
+        size_t const num_hot = 50;
+        LRUCache<size_t,size_t,P> cache(100);
+        for (size_t round=0; round<10; ++round) {
+            for (size_t repetition=0; repetition<2; ++repetition)
+                for (size_t i=0; i<num_hot; ++i) cache.get_or_compute(i,[i]{ return i; });
+            for (size_t i=0; i<60; ++i) cache.get_or_compute(100+round*60+i,[i]{ return i; });
+        }
+        for (size_t i=0; i<num_hot; ++i) cache.get_or_compute(i,[i]{ return i; });
+        for (size_t i=1000; i<1500; ++i) cache.get_or_compute(i,[i]{ return i; });
+        size_t result = 0;
+        for (size_t i=0; i<num_hot; ++i) if (cache.has_label(i)) ++result;
+        return result;
+    }
+
+    void test_frequency_sketch() {
+        FrequencySketch<size_t> sketch(64);
+        HELPER_TEST_EQUALS(sketch.frequency(1),0);
+        for (size_t i=0; i<5; ++i) sketch.increment(1);
+        sketch.increment(2);
+        HELPER_TEST_ASSERT(sketch.frequency(1) >= 5);
+        HELPER_TEST_ASSERT(sketch.frequency(2) >= 1);
+        for (size_t i=0; i<100; ++i) sketch.increment(3);
+        HELPER_TEST_EQUALS(sketch.frequency(3),15);
+    }
+
+    void test_frequency_sketch_aging() {
+        FrequencySketch<size_t> sketch(16);
+        for (size_t i=0; i<10; ++i) sketch.increment(1);
+        for (size_t i=0; i<160; ++i) sketch.increment(1000+i);
+        HELPER_TEST_ASSERT(sketch.frequency(1) < 10);
+    }
+
+    void test_two_queue_ghost_promotion() {
+        LRUCache<size_t,size_t,TwoQueueEviction<size_t>> cache(4);
+        for (size_t i=0; i<5; ++i) cache.put(i,i);
+        HELPER_TEST_ASSERT(not cache.has_label(0));
+        cache.put(0,0);
+        for (size_t i=10; i<20; ++i) cache.put(i,i);
+        HELPER_TEST_ASSERT(cache.has_label(0));
+    }
+
+    void test_arc_adaptation() {
+        LRUCache<size_t,size_t,ARCEviction<size_t>> cache(4);
+        HELPER_TEST_EQUALS(cache.policy().recent_target(),0);
+        cache.put(0,0);
+        cache.put(1,1);
+        cache.get(0);
+        cache.get(1);
+        cache.put(2,2);
+        cache.put(3,3);
+        cache.put(4,4);
+        HELPER_TEST_ASSERT(not cache.has_label(2));
+        cache.put(2,2);
+        HELPER_TEST_EQUALS(cache.policy().recent_target(),1);
+        HELPER_TEST_ASSERT(cache.has_label(0));
+        HELPER_TEST_ASSERT(cache.has_label(1));
+    }
+
+    void test_scan_resistance() {
+        HELPER_TEST_EQUALS(hot_labels_after_scan<LRUEviction<size_t>>(),0);
+        HELPER_TEST_COMPARE(hot_labels_after_scan<TwoQueueEviction<size_t>>(),>=,45);
+        HELPER_TEST_COMPARE(hot_labels_after_scan<ARCEviction<size_t>>(),>=,45);
+        HELPER_TEST_COMPARE(hot_labels_after_scan<TinyLFUEviction<size_t>>(),>=,45);
+    }
+
+    void test_unbounded_size() {
+        auto weigher = [](size_t const&, size_t const&){ return size_t(1); };
+        HELPER_TEST_FAIL((LRUCache<size_t,size_t,TwoQueueEviction<size_t>>(std::numeric_limits<size_t>::max(),10,weigher)));
+        HELPER_TEST_FAIL((LRUCache<size_t,size_t,ARCEviction<size_t>>(std::numeric_limits<size_t>::max(),10,weigher)));
+        HELPER_TEST_FAIL((LRUCache<size_t,size_t,TinyLFUEviction<size_t>>(std::numeric_limits<size_t>::max(),10,weigher)));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_consistency<LRUEviction<size_t>>());
+        HELPER_TEST_CALL(test_consistency<TwoQueueEviction<size_t>>());
+        HELPER_TEST_CALL(test_consistency<ARCEviction<size_t>>());
+        HELPER_TEST_CALL(test_consistency<TinyLFUEviction<size_t>>());
+        HELPER_TEST_CALL(test_frequency_sketch());
+        HELPER_TEST_CALL(test_frequency_sketch_aging());
+        HELPER_TEST_CALL(test_two_queue_ghost_promotion());
+        HELPER_TEST_CALL(test_arc_adaptation());
+        HELPER_TEST_CALL(test_scan_resistance());
+        HELPER_TEST_CALL(test_unbounded_size());
+    }
+
+};
+
+int main() {
+    TestEvictionPolicy().test();
+    return HELPER_TEST_FAILURES;
+}
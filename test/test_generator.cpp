@@ -0,0 +1,138 @@
+/***************************************************************************
+ *            test_generator.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "array.hpp"
+#include "container.hpp"
+#include "generator.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+// GCC reports the switch it generates for resuming a coroutine at the end of its body
+#if defined(__GNUC__) and not defined(__clang__)
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+
+Generator<size_t> squares(size_t n) {
+    for (size_t i=0; i<n; ++i) co_yield i*i;
+}
+
+Generator<size_t> naturals(size_t& produced) {
+    for (size_t i=0; ; ++i) {
+        ++produced;
+        co_yield i;
+    }
+}
+
+Generator<int> failing() {
+    co_yield 1;
+    throw std::runtime_error("generator failure");
+}
+
+Generator<std::unique_ptr<int>> boxed(int n) {
+    for (int i=0; i<n; ++i) co_yield std::make_unique<int>(i);
+}
+
+class TestGenerator {
+  public:
+
+    void test_range_for() {
+        size_t sum = 0, count = 0;
+        for (auto value : squares(5)) { sum += value; ++count; }
+        HELPER_TEST_EQUALS(count,5);
+        HELPER_TEST_EQUALS(sum,30);
+        size_t empty_count = 0;
+        for ([[maybe_unused]] auto value : squares(0)) ++empty_count;
+        HELPER_TEST_EQUALS(empty_count,0);
+    }
+
+    void test_on_demand() {
+        size_t produced = 0;
+        auto gen = naturals(produced);
+        HELPER_TEST_EQUALS(produced,0);
+        size_t last = 0;
+        for (auto value : gen) {
+            last = value;
+            if (value == 9) break;
+        }
+        HELPER_TEST_EQUALS(last,9);
+        HELPER_TEST_EQUALS(produced,10);
+    }
+
+    void test_containers() {
+        auto gen = squares(4);
+        List<size_t> lst(gen.begin(),gen.end());
+        HELPER_TEST_EQUALS(lst,List<size_t>({0,1,4,9}));
+        auto other = squares(3);
+        Array<size_t> ary(other.begin(),other.end());
+        HELPER_TEST_EQUALS(ary.size(),3);
+        HELPER_TEST_EQUALS(ary[2],4);
+    }
+
+    void test_move_only() {
+        int sum = 0;
+        for (auto const& ptr : boxed(4)) sum += *ptr;
+        HELPER_TEST_EQUALS(sum,6);
+    }
+
+    void test_exception() {
+        auto gen = failing();
+        auto it = gen.begin();
+        HELPER_TEST_EQUALS(*it,1);
+        HELPER_TEST_FAIL(++it);
+        HELPER_TEST_ASSERT(it == gen.end());
+    }
+
+    void test_move() {
+        auto gen = squares(3);
+        auto moved = std::move(gen);
+        size_t count = 0;
+        for ([[maybe_unused]] auto value : moved) ++count;
+        HELPER_TEST_EQUALS(count,3);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_range_for());
+        HELPER_TEST_CALL(test_on_demand());
+        HELPER_TEST_CALL(test_containers());
+        HELPER_TEST_CALL(test_move_only());
+        HELPER_TEST_CALL(test_exception());
+        HELPER_TEST_CALL(test_move());
+    }
+
+};
+
+int main() {
+    TestGenerator().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *            test_latency_histogram.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "latency_histogram.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+using namespace std::chrono_literals;
+
+class TestLatencyHistogram {
+  public:
+
+    void test_empty() {
+        LatencyHistogram histogram;
+        HELPER_TEST_EQUALS(histogram.total_count(),0);
+        HELPER_TEST_EQUALS(histogram.value_at_percentile(50.0),0);
+        HELPER_TEST_EQUALS(histogram.max(),0);
+        HELPER_TEST_EQUALS(histogram.mean(),0.0);
+        HELPER_TEST_FAIL(LatencyHistogram(1000,0));
+        HELPER_TEST_FAIL(LatencyHistogram(1000,6));
+    }
+
+    void test_exact_small_values() {
+        LatencyHistogram histogram(1000000,3);
+        for (std::int64_t v=0; v<2000; ++v) histogram.record(v);
+        HELPER_TEST_EQUALS(histogram.min(),0);
+        HELPER_TEST_EQUALS(histogram.max(),1999);
+        HELPER_TEST_EQUALS(histogram.value_at_percentile(50.0),999);
+        HELPER_TEST_EQUALS(histogram.value_at_percentile(100.0),1999);
+        HELPER_TEST_EQUALS(histogram.mean(),999.5);
+    }
+
+    void test_precision() {
+        for (unsigned int digits=1; digits<=4; ++digits) {
+            LatencyHistogram histogram(3600'000'000'000, digits);
+            double tolerance = std::pow(10.0, -static_cast<double>(digits));
+            for (std::int64_t v : {std::int64_t(1234), std::int64_t(987654), std::int64_t(123456789), std::int64_t(3'000'000'000'000)}) {
+                histogram.reset();
+                histogram.record(v);
+                histogram.record(v+1);
+                auto reported = histogram.value_at_percentile(0.0);
+                HELPER_TEST_ASSERT(reported >= v);
+                HELPER_TEST_ASSERT(static_cast<double>(reported-v) <= tolerance*static_cast<double>(v));
+            }
+            HELPER_TEST_PRINT(histogram.number_of_counters())
+        }
+    }
+
+    void test_percentiles() {
+        LatencyHistogram histogram;
+        for (std::int64_t v=1; v<=1000000; ++v) histogram.record(v);
+        auto p = histogram.percentiles();
+        HELPER_TEST_PRINT(p)
+        HELPER_TEST_ASSERT(std::abs(static_cast<double>(p.p50)-500000.0) <= 500.0);
+        HELPER_TEST_ASSERT(std::abs(static_cast<double>(p.p90)-900000.0) <= 900.0);
+        HELPER_TEST_ASSERT(std::abs(static_cast<double>(p.p99)-990000.0) <= 990.0);
+        HELPER_TEST_ASSERT(std::abs(static_cast<double>(p.p999)-999000.0) <= 999.0);
+        HELPER_TEST_EQUALS(p.max,1000000);
+        HELPER_TEST_ASSERT(std::abs(histogram.mean()-500000.5) <= 500.0);
+    }
+
+    void test_out_of_range() {
+        LatencyHistogram histogram(1000000,2);
+        histogram.record(-5);
+        histogram.record(5000000);
+        HELPER_TEST_EQUALS(histogram.total_count(),2);
+        HELPER_TEST_EQUALS(histogram.min(),0);
+        HELPER_TEST_EQUALS(histogram.max(),5000000);
+        HELPER_TEST_EQUALS(histogram.value_at_percentile(0.0),0);
+        HELPER_TEST_ASSERT(histogram.value_at_percentile(100.0) >= 1000000);
+        LatencyHistogram negative;
+        negative.record(-7);
+        negative.record(-3);
+        HELPER_TEST_EQUALS(negative.min(),0);
+        HELPER_TEST_EQUALS(negative.max(),0);
+        HELPER_TEST_EQUALS(negative.value_at_percentile(100.0),0);
+    }
+
+    void test_merge() {
+        size_t const num_threads = 4;
+        std::vector<LatencyHistogram> histograms(num_threads);
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t)
+            threads.emplace_back([&histograms,t]{
+                for (std::int64_t v=0; v<10000; ++v) histograms[t].record(static_cast<std::int64_t>(t)*10000+v);
+            });
+        for (auto& thread : threads) thread.join();
+        LatencyHistogram total;
+        for (auto const& histogram : histograms) total += histogram;
+        HELPER_TEST_EQUALS(total.total_count(),40000);
+        HELPER_TEST_EQUALS(total.min(),0);
+        HELPER_TEST_EQUALS(total.max(),39999);
+        HELPER_TEST_ASSERT(std::abs(static_cast<double>(total.value_at_percentile(50.0))-20000.0) <= 20.0);
+        HELPER_TEST_FAIL(total += LatencyHistogram(1000,3));
+    }
+
+    void test_stopwatch() {
+        LatencyHistogram histogram;
+        Stopwatch<Microseconds> sw;
+        CycleStopwatch<Microseconds> csw;
+        std::this_thread::sleep_for(1ms);
+        histogram.record(sw.click());
+        histogram.record(csw.click());
+        histogram.record(2ms);
+        HELPER_TEST_EQUALS(histogram.total_count(),3);
+        HELPER_TEST_ASSERT(histogram.min() >= 1000000);
+        HELPER_TEST_ASSERT(histogram.max() >= 2000000);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_empty());
+        HELPER_TEST_CALL(test_exact_small_values());
+        HELPER_TEST_CALL(test_precision());
+        HELPER_TEST_CALL(test_percentiles());
+        HELPER_TEST_CALL(test_out_of_range());
+        HELPER_TEST_CALL(test_merge());
+        HELPER_TEST_CALL(test_stopwatch());
+    }
+
+};
+
+int main() {
+    TestLatencyHistogram().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -26,7 +26,12 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "lazy.hpp"
 
 #include "test.hpp"
@@ -40,12 +45,22 @@ class TestClass {
         HELPER_TEST_PRINT("TestClass object created")
     }
 
-    double value() { return _value; }
+    double value() const { return _value; }
 
   private:
     double _value;
 };
 
+//! \brief An object that can be neither copied nor moved
+class PinnedClass {
+  public:
+    PinnedClass(double a) : _value(a) { }
+    PinnedClass(PinnedClass const&) = delete;
+    double value() const { return _value; }
+  private:
+    double _value;
+};
+
 class TestLazy {
   public:
 
@@ -58,8 +73,227 @@ class TestLazy {
         HELPER_TEST_EQUAL(obj.value(),4.0)
     }
 
+    void test_copy() {
+        size_t calls = 0;
+        Lazy<double> lazy([&calls]{ ++calls; return new double(1.0); });
+        Lazy<double> copy(lazy);
+        HELPER_TEST_ASSERT(not copy.is_created());
+        HELPER_TEST_EQUAL(lazy(),1.0)
+        HELPER_TEST_ASSERT(copy.is_created());
+        HELPER_TEST_EQUAL(copy(),1.0)
+        HELPER_TEST_EQUALS(calls,1);
+        HELPER_TEST_ASSERT(&copy() == &lazy());
+    }
+
+    void test_failure() {
+        size_t calls = 0;
+        Lazy<double> lazy([&calls]() -> double* { if (++calls == 1) throw std::runtime_error("first call fails"); return new double(2.0); });
+        HELPER_TEST_FAIL(lazy());
+        HELPER_TEST_ASSERT(not lazy.is_created());
+        HELPER_TEST_EQUAL(lazy(),2.0)
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_multiple_threads() {
+        size_t const num_threads = 16;
+        size_t const num_accesses = 10000;
+        std::atomic<size_t> calls = 0;
+        std::atomic<bool> start = false;
+        std::atomic<size_t> mismatches = 0;
+        Lazy<TestClass> lazy([&calls]{ ++calls; std::this_thread::sleep_for(std::chrono::milliseconds(10)); return new TestClass(3.0); });
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&]{
+                while (not start.load()) { }
+                auto first = &lazy();
+                for (size_t i=0; i<num_accesses; ++i)
+                    if (&lazy() != first or lazy().value() != 9.0) ++mismatches;
+            });
+        }
+        start = true;
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(calls,1);
+        HELPER_TEST_EQUALS(mismatches,0);
+    }
+
+    void test_prefetch() {
+        ThreadPool pool(1);
+        std::atomic<size_t> calls = 0;
+        std::atomic<bool> release = false;
+        Lazy<double> lazy([&]{ ++calls; while (not release.load()) std::this_thread::yield(); return new double(4.0); });
+        lazy.prefetch(pool);
+        while (calls.load() == 0) std::this_thread::yield();
+        HELPER_TEST_ASSERT(not lazy.is_created());
+        release = true;
+        HELPER_TEST_EQUAL(lazy(),4.0)
+        HELPER_TEST_EQUALS(calls,1);
+        lazy.prefetch(pool);
+        HELPER_TEST_EQUALS(pool.queue_size(),0);
+    }
+
+    void test_prefetch_discarded() {
+        std::atomic<size_t> calls = 0;
+        std::atomic<bool> started = false;
+        std::atomic<bool> release = false;
+        {
+            ThreadPool pool(1);
+            pool.enqueue([&]{ started = true; while (not release.load()) std::this_thread::yield(); });
+            while (not started.load()) std::this_thread::yield();
+            {
+                Lazy<double> lazy([&calls]{ ++calls; return new double(1.0); });
+                lazy.prefetch(pool);
+                HELPER_TEST_EQUALS(pool.queue_size(),1);
+            }
+            release = true;
+        }
+        HELPER_TEST_EQUALS(calls,0);
+    }
+
+    void test_inline() {
+        size_t calls = 0;
+        auto lazy = make_lazy([&calls]{ ++calls; return PinnedClass(5.0); });
+        static_assert(sizeof(lazy) <= 3*sizeof(void*), "The inline lazy object holds the function, the state and the object only");
+        HELPER_TEST_ASSERT(not lazy.is_created());
+        HELPER_TEST_EQUAL(lazy().value(),5.0)
+        HELPER_TEST_EQUAL(lazy().value(),5.0)
+        HELPER_TEST_EQUALS(calls,1);
+
+        auto counted = make_lazy([&calls]{ ++calls; return std::vector<int>(3,1); });
+        counted();
+        auto copy = counted;
+        auto moved = std::move(counted);
+        HELPER_TEST_ASSERT(copy.is_created() and moved.is_created());
+        HELPER_TEST_EQUALS(copy().size(),3);
+        HELPER_TEST_EQUALS(moved().size(),3);
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_inline_failure() {
+        size_t calls = 0;
+        auto lazy = make_lazy([&calls]{ if (++calls == 1) throw std::runtime_error("first call fails"); return 2.0; });
+        HELPER_TEST_FAIL(lazy());
+        HELPER_TEST_ASSERT(not lazy.is_created());
+        HELPER_TEST_EQUAL(lazy(),2.0)
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_inline_multiple_threads() {
+        size_t const num_threads = 16;
+        size_t const num_accesses = 10000;
+        std::atomic<size_t> calls = 0;
+        std::atomic<bool> start = false;
+        std::atomic<size_t> mismatches = 0;
+        auto lazy = make_lazy([&calls]{ ++calls; std::this_thread::sleep_for(std::chrono::milliseconds(10)); return PinnedClass(3.0); });
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&]{
+                while (not start.load()) { }
+                for (size_t i=0; i<num_accesses; ++i)
+                    if (lazy().value() != 3.0) ++mismatches;
+            });
+        }
+        start = true;
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(calls,1);
+        HELPER_TEST_EQUALS(mismatches,0);
+    }
+
+    void test_evictable() {
+        MemoryBudget budget(2*sizeof(double));
+        size_t calls = 0;
+        EvictableLazy<double> a([&calls]{ ++calls; return new double(1.0); }, [](double const&) { return sizeof(double); }, budget);
+        EvictableLazy<double> b([&calls]{ ++calls; return new double(2.0); }, [](double const&) { return sizeof(double); }, budget);
+        EvictableLazy<double> c([&calls]{ ++calls; return new double(3.0); }, [](double const&) { return sizeof(double); }, budget);
+        HELPER_TEST_ASSERT(not a.is_created());
+        HELPER_TEST_EQUALS(*a(),1.0);
+        auto held = b();
+        HELPER_TEST_EQUALS(*a(),1.0);
+        HELPER_TEST_EQUALS(budget.used(),2*sizeof(double));
+        HELPER_TEST_EQUALS(*c(),3.0);
+        HELPER_TEST_ASSERT(a.is_created());
+        HELPER_TEST_ASSERT(not b.is_created());
+        HELPER_TEST_ASSERT(c.is_created());
+        HELPER_TEST_EQUALS(*held,2.0);
+        HELPER_TEST_EQUALS(budget.number_of_evictions(),1);
+        HELPER_TEST_EQUALS(budget.number_of_entries(),2);
+        HELPER_TEST_EQUALS(calls,3);
+        HELPER_TEST_EQUALS(*b(),2.0);
+        HELPER_TEST_EQUALS(calls,4);
+        HELPER_TEST_ASSERT(not a.is_created());
+        budget.set_capacity(sizeof(double));
+        HELPER_TEST_EQUALS(budget.number_of_entries(),1);
+        HELPER_TEST_ASSERT(b.is_created());
+        HELPER_TEST_EQUALS(budget.used(),sizeof(double));
+    }
+
+    void test_evictable_oversized() {
+        MemoryBudget budget(1);
+        EvictableLazy<double> a([]{ return new double(1.0); }, [](double const&) { return sizeof(double); }, budget);
+        HELPER_TEST_EQUALS(*a(),1.0);
+        HELPER_TEST_ASSERT(a.is_created());
+        {
+            EvictableLazy<double> b([]{ return new double(2.0); }, [](double const&) { return sizeof(double); }, budget);
+            HELPER_TEST_EQUALS(*b(),2.0);
+            HELPER_TEST_ASSERT(not a.is_created());
+        }
+        HELPER_TEST_EQUALS(budget.number_of_entries(),0);
+        HELPER_TEST_EQUALS(budget.used(),0);
+    }
+
+    void test_evictable_nested() {
+        MemoryBudget budget(2*sizeof(int));
+        auto int_size = [](int const&) { return sizeof(int); };
+        EvictableLazy<EvictableLazy<int>> outer([&]{ return new EvictableLazy<int>([]{ return new int(1); }, int_size, budget); },
+                                                [](EvictableLazy<int> const&) { return sizeof(int); }, budget);
+        HELPER_TEST_EQUALS(*(*outer())(),1);
+        HELPER_TEST_EQUALS(budget.number_of_entries(),2);
+        EvictableLazy<int> other([]{ return new int(2); }, int_size, budget);
+        HELPER_TEST_EQUALS(*other(),2);
+        HELPER_TEST_ASSERT(not outer.is_created());
+        HELPER_TEST_EQUALS(budget.number_of_evictions(),1);
+        HELPER_TEST_EQUALS(budget.number_of_entries(),1);
+        HELPER_TEST_EQUALS(budget.used(),sizeof(int));
+        HELPER_TEST_EQUALS(*(*outer())(),1);
+    }
+
+    void test_evictable_multiple_threads() {
+        size_t const num_threads = 8;
+        size_t const num_lazies = 32;
+        size_t const num_accesses = 2000;
+        MemoryBudget budget(8*sizeof(size_t));
+        std::vector<EvictableLazy<size_t>> lazies;
+        for (size_t i=0; i<num_lazies; ++i)
+            lazies.emplace_back([i]{ return new size_t(i); }, [](size_t const&) { return sizeof(size_t); }, budget);
+        std::atomic<size_t> mismatches = 0;
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&,t]{
+                for (size_t i=0; i<num_accesses; ++i) {
+                    size_t idx = (i*7+t*13)%num_lazies;
+                    if (*lazies[idx]() != idx) ++mismatches;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(mismatches,0);
+        HELPER_TEST_ASSERT(budget.used() <= 8*sizeof(size_t));
+        HELPER_TEST_EQUALS(budget.used(),budget.number_of_entries()*sizeof(size_t));
+    }
+
     void test() {
         HELPER_TEST_CALL(test_creation());
+        HELPER_TEST_CALL(test_copy());
+        HELPER_TEST_CALL(test_failure());
+        HELPER_TEST_CALL(test_multiple_threads());
+        HELPER_TEST_CALL(test_prefetch());
+        HELPER_TEST_CALL(test_prefetch_discarded());
+        HELPER_TEST_CALL(test_inline());
+        HELPER_TEST_CALL(test_inline_failure());
+        HELPER_TEST_CALL(test_inline_multiple_threads());
+        HELPER_TEST_CALL(test_evictable());
+        HELPER_TEST_CALL(test_evictable_oversized());
+        HELPER_TEST_CALL(test_evictable_nested());
+        HELPER_TEST_CALL(test_evictable_multiple_threads());
     }
 
 };
@@ -27,6 +27,13 @@
  */
 
 #include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 
 #include "string.hpp"
 #include "lru_cache.hpp"
@@ -37,6 +44,29 @@ using namespace Helper;
 
 using CacheType = LRUCache<String,int>;
 
+//! \brief A value counting its copies and moves
+struct CountedValue {
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+    CountedValue(int v) : value(v) { }
+    CountedValue(CountedValue const& other) : value(other.value) { ++copies; }
+    CountedValue(CountedValue&& other) : value(other.value) { ++moves; }
+    int value;
+};
+
+//! \brief Serialization of strings as their characters
+struct StringSerializer {
+    void serialize(String const& str, std::string& buffer) const { buffer.append(str); }
+    String deserialize(std::string_view bytes) const { return String(std::string(bytes)); }
+};
+
+//! \brief A value that can be neither copied nor moved
+struct PinnedValue {
+    PinnedValue(int v, int w) : value(v+w) { }
+    PinnedValue(PinnedValue const&) = delete;
+    int value;
+};
+
 class TestLRUCache {
   public:
 
@@ -101,6 +131,303 @@ class TestLRUCache {
         HELPER_TEST_EQUALS(cache.age("fourth"),1);
     }
 
+    void test_get_then_put_over() {
+        CacheType cache(3);
+        cache.put("first",42);
+        cache.put("second",10);
+        cache.put("third",5);
+        cache.get("first");
+        cache.put("fourth",12);
+        HELPER_TEST_EQUALS(cache.current_size(),3);
+        HELPER_TEST_ASSERT(not cache.has_label("second"));
+        HELPER_TEST_EQUALS(cache.age("first"),1);
+        HELPER_TEST_EQUALS(cache.age("third"),2);
+        HELPER_TEST_EQUALS(cache.age("fourth"),0);
+    }
+
+    void test_weighted_construct() {
+        auto weigher = [](String const&, int const& val){ return static_cast<size_t>(val); };
+        HELPER_TEST_FAIL(CacheType(2,0,weigher));
+        CacheType cache(2,100,weigher);
+        HELPER_TEST_EQUALS(cache.current_weight(),0);
+        HELPER_TEST_EQUALS(cache.maximum_weight(),100);
+        HELPER_TEST_FAIL(cache.put("first",101));
+        HELPER_TEST_EQUALS(cache.current_size(),0);
+    }
+
+    void test_weighted_put() {
+        CacheType cache(std::numeric_limits<size_t>::max(),100,[](String const&, int const& val){ return static_cast<size_t>(val); });
+        cache.put("first",40);
+        cache.put("second",30);
+        cache.put("third",20);
+        HELPER_TEST_EQUALS(cache.current_size(),3);
+        HELPER_TEST_EQUALS(cache.current_weight(),90);
+        cache.get("first");
+        cache.put("fourth",50);
+        HELPER_TEST_EQUALS(cache.current_size(),2);
+        HELPER_TEST_EQUALS(cache.current_weight(),90);
+        HELPER_TEST_ASSERT(cache.has_label("first"));
+        HELPER_TEST_ASSERT(cache.has_label("fourth"));
+        cache.put("fifth",1,100);
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+        HELPER_TEST_EQUALS(cache.current_weight(),100);
+    }
+
+    void test_weighted_and_sized() {
+        CacheType cache(2,100,[](String const&, int const& val){ return static_cast<size_t>(val); });
+        cache.put("first",10);
+        cache.put("second",10);
+        cache.put("third",10);
+        HELPER_TEST_EQUALS(cache.current_size(),2);
+        HELPER_TEST_EQUALS(cache.current_weight(),20);
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+    }
+
+    void test_throwing_weigher() {
+        CacheType cache(2,100,[](String const&, int const& val){
+            if (val < 0) throw std::invalid_argument("negative value");
+            return static_cast<size_t>(val); });
+        cache.put("first",10);
+        HELPER_TEST_FAIL(cache.put("second",-1));
+        HELPER_TEST_ASSERT(not cache.has_label("second"));
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+        HELPER_TEST_EQUALS(cache.current_weight(),10);
+        HELPER_TEST_ASSERT(not cache.erase("second"));
+        cache.put("second",20);
+        HELPER_TEST_ASSERT(cache.erase("second"));
+        cache.put("third",30);
+        cache.put("fourth",40);
+        HELPER_TEST_EQUALS(cache.current_size(),2);
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+    }
+
+    void test_get_or_compute() {
+        CacheType cache(2);
+        size_t calls = 0;
+        auto factory = [&calls]{ ++calls; return 42; };
+        HELPER_TEST_EQUALS(cache.get_or_compute("first",factory),42);
+        HELPER_TEST_EQUALS(cache.get_or_compute("first",factory),42);
+        HELPER_TEST_EQUALS(calls,1);
+        cache.put("second",10);
+        HELPER_TEST_EQUALS(cache.get_or_compute("first",factory),42);
+        HELPER_TEST_EQUALS(cache.age("first"),0);
+        HELPER_TEST_EQUALS(calls,1);
+    }
+
+    void test_erase() {
+        CacheType cache(3);
+        cache.put("first",42);
+        cache.put("second",10);
+        HELPER_TEST_ASSERT(cache.erase("first"));
+        HELPER_TEST_ASSERT(not cache.erase("first"));
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+        HELPER_TEST_EQUALS(cache.age("second"),0);
+        cache.put("first",5);
+        HELPER_TEST_EQUALS(cache.get("first"),5);
+    }
+
+    void test_try_get() {
+        CacheType cache(2);
+        cache.put("first",42);
+        cache.put("second",10);
+        HELPER_TEST_ASSERT(cache.try_get("third") == nullptr);
+        auto ptr = cache.try_get("first");
+        HELPER_TEST_ASSERT(ptr != nullptr);
+        HELPER_TEST_EQUALS(*ptr,42);
+        HELPER_TEST_EQUALS(cache.age("first"),0);
+    }
+
+    void test_many() {
+        CacheType cache(3);
+        std::vector<String> labels = {"first","second","third"};
+        std::vector<int> values = {1,2,3};
+        cache.put_many(labels,values);
+        std::vector<String> others = {"second","fourth","first"};
+        auto batch = cache.get_many(others);
+        HELPER_TEST_EQUALS(batch.values.size(),3);
+        HELPER_TEST_EQUALS(*batch.values[0],2);
+        HELPER_TEST_ASSERT(batch.values[1] == nullptr);
+        HELPER_TEST_EQUALS(*batch.values[2],1);
+        HELPER_TEST_EQUALS(batch.misses.size(),1);
+        HELPER_TEST_EQUALS(batch.misses[0],1);
+        HELPER_TEST_EQUALS(cache.age("first"),0);
+        HELPER_TEST_EQUALS(cache.age("second"),1);
+        HELPER_TEST_EQUALS(cache.age("third"),2);
+        HELPER_TEST_FAIL(cache.put_many(labels,std::span<int const>(values).subspan(0,2)));
+    }
+
+    void test_heterogeneous_lookup() {
+        CacheType cache(2);
+        cache.put("a label long enough to be allocated",1);
+        std::string_view view = "a label long enough to be allocated";
+        HELPER_TEST_ASSERT(cache.has_label(view));
+        HELPER_TEST_EQUALS(cache.get(view),1);
+        HELPER_TEST_EQUALS(*cache.try_get(view),1);
+        HELPER_TEST_ASSERT(cache.try_get(std::string_view("other")) == nullptr);
+        HELPER_TEST_EQUALS(cache.get_or_compute(std::string_view("other"),[]{ return 2; }),2);
+        HELPER_TEST_EQUALS(cache.age(view),1);
+        HELPER_TEST_ASSERT(cache.erase(view));
+        HELPER_TEST_ASSERT(not cache.has_label("a label long enough to be allocated"));
+    }
+
+    void test_move_only() {
+        LRUCache<String,std::unique_ptr<int>> cache(2);
+        cache.put("first",std::make_unique<int>(42));
+        cache.emplace("second",new int(10));
+        HELPER_TEST_EQUALS(*cache.get("first"),42);
+        HELPER_TEST_EQUALS(*cache.get_or_compute("third",[]{ return std::make_unique<int>(7); }),7);
+        HELPER_TEST_ASSERT(not cache.has_label("second"));
+        HELPER_TEST_EQUALS(**cache.try_get("first"),42);
+    }
+
+    void test_emplace() {
+        LRUCache<String,PinnedValue> cache(1);
+        HELPER_TEST_EQUALS(cache.emplace("first",40,2).value,42);
+        HELPER_TEST_EQUALS(cache.get("first").value,42);
+        HELPER_TEST_FAIL(cache.emplace("first",1,2));
+        cache.emplace("second",1,2);
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+    }
+
+    void test_no_copies() {
+        LRUCache<String,CountedValue> cache(2,100,[](String const&, CountedValue const& v){ return size_t(v.value); });
+        CountedValue::copies = 0;
+        CountedValue::moves = 0;
+        cache.emplace("first",10);
+        cache.put("second",CountedValue(20));
+        cache.get_or_compute("third",[]{ return CountedValue(30); });
+        cache.put("fourth",40,50);
+        HELPER_TEST_EQUALS(cache.get("fourth").value,40);
+        HELPER_TEST_EQUALS(cache.current_weight(),80);
+        HELPER_TEST_FAIL(cache.emplace("fifth",200));
+        HELPER_TEST_ASSERT(not cache.has_label("fifth"));
+        HELPER_TEST_EQUALS(CountedValue::copies,0);
+        HELPER_TEST_EQUALS(CountedValue::moves,2);
+    }
+
+    void test_snapshot() {
+        auto path = (std::filesystem::temp_directory_path() / "helper_test_lru_cache.snapshot").string();
+        CacheType cache(3);
+        cache.put("first",1);
+        cache.put("second",2);
+        cache.put("third",3,std::chrono::hours(1));
+        cache.get("first");
+        HELPER_TEST_ASSERT(cache.save(path,StringSerializer(),TrivialSerializer<int>(),1));
+
+        CacheType restored(3);
+        HELPER_TEST_ASSERT(restored.load(path,StringSerializer(),TrivialSerializer<int>(),1));
+        HELPER_TEST_EQUALS(restored.current_size(),3);
+        HELPER_TEST_EQUALS(restored.age("first"),0);
+        HELPER_TEST_EQUALS(restored.age("third"),1);
+        HELPER_TEST_EQUALS(restored.age("second"),2);
+        HELPER_TEST_EQUALS(restored.get("third"),3);
+
+        CacheType smaller(2);
+        HELPER_TEST_ASSERT(smaller.load(path,StringSerializer(),TrivialSerializer<int>(),1));
+        HELPER_TEST_EQUALS(smaller.current_size(),2);
+        HELPER_TEST_ASSERT(not smaller.has_label("second"));
+
+        HELPER_TEST_ASSERT(not restored.load(path,StringSerializer(),TrivialSerializer<int>(),2));
+        HELPER_TEST_EQUALS(restored.current_size(),0);
+
+        LRUCache<String,long> mismatched(3);
+        HELPER_TEST_ASSERT(not mismatched.load(path,StringSerializer(),TrivialSerializer<long>(),1));
+
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(40);
+            file.put('X');
+        }
+        HELPER_TEST_ASSERT(not restored.load(path,StringSerializer(),TrivialSerializer<int>(),1));
+        HELPER_TEST_EQUALS(restored.current_size(),0);
+
+        std::filesystem::remove(path);
+        HELPER_TEST_ASSERT(not restored.load(path,StringSerializer(),TrivialSerializer<int>(),1));
+    }
+
+    void test_snapshot_expiry() {
+        auto path = (std::filesystem::temp_directory_path() / "helper_test_lru_cache_expiry.snapshot").string();
+        CacheType cache(3);
+        cache.put("short",1,std::chrono::milliseconds(50));
+        cache.put("long",2,std::chrono::hours(1));
+        cache.put("forever",3);
+        HELPER_TEST_ASSERT(cache.save(path,StringSerializer(),TrivialSerializer<int>()));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        CacheType restored(3);
+        HELPER_TEST_ASSERT(restored.load(path,StringSerializer(),TrivialSerializer<int>()));
+        HELPER_TEST_EQUALS(restored.current_size(),2);
+        HELPER_TEST_ASSERT(not restored.has_label("short"));
+        HELPER_TEST_EQUALS(restored.get("long"),2);
+        HELPER_TEST_EQUALS(restored.get("forever"),3);
+        std::filesystem::remove(path);
+    }
+
+    void test_time_to_live() {
+        CacheType cache(3);
+        cache.put("first",42,std::chrono::milliseconds(20));
+        cache.put("second",10);
+        HELPER_TEST_ASSERT(cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.get("first"),42);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_FAIL(cache.get("first"));
+        HELPER_TEST_ASSERT(cache.has_label("second"));
+        cache.put("first",5,std::chrono::milliseconds(1000));
+        HELPER_TEST_EQUALS(cache.get("first"),5);
+    }
+
+    void test_expire() {
+        CacheType cache(10);
+        for (int i=0; i<5; ++i) cache.put(to_string(i),i,std::chrono::milliseconds(10));
+        cache.put("permanent",42);
+        HELPER_TEST_EQUALS(cache.current_size(),6);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        cache.expire();
+        HELPER_TEST_EQUALS(cache.current_size(),1);
+        HELPER_TEST_ASSERT(cache.has_label("permanent"));
+    }
+
+    void test_statistics() {
+        CacheType cache(2);
+        HELPER_TEST_EQUALS(cache.statistics().hits,0);
+        HELPER_TEST_EQUALS(cache.statistics().hit_ratio(),0.0);
+        cache.put("first",42);
+        cache.put("second",10);
+        cache.get("first");
+        HELPER_TEST_ASSERT(not cache.has_label("third"));
+        cache.put("third",5);
+        cache.get_or_compute("third",[]{ return 5; });
+        cache.get_or_compute("fourth",[]{ return 7; });
+        HELPER_TEST_FAIL(cache.get("second"));
+        cache.put("fifth",1,std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cache.expire();
+        auto statistics = cache.statistics();
+        HELPER_TEST_PRINT(statistics);
+        HELPER_TEST_EQUALS(statistics.hits,2);
+        HELPER_TEST_EQUALS(statistics.misses,3);
+        HELPER_TEST_EQUALS(statistics.insertions,5);
+        HELPER_TEST_EQUALS(statistics.evictions,3);
+        HELPER_TEST_EQUALS(statistics.expirations,1);
+        HELPER_TEST_EQUALS(statistics.total_evicted_age,6);
+        HELPER_TEST_EQUALS(statistics.maximum_evicted_age,3);
+        HELPER_TEST_EQUALS(statistics.latency_samples,0);
+        HELPER_TEST_EQUALS(statistics.hit_ratio(),0.4);
+    }
+
+    void test_latency_sampling() {
+        CacheType cache(2);
+        cache.put("first",42);
+        cache.set_latency_sampling_period(2);
+        for (size_t i=0; i<10; ++i) cache.get("first");
+        auto statistics = cache.statistics();
+        HELPER_TEST_EQUALS(statistics.latency_samples,5);
+        HELPER_TEST_ASSERT(statistics.maximum_latency >= statistics.average_latency());
+    }
+
     void test() {
         HELPER_TEST_CALL(test_construct());
         HELPER_TEST_CALL(test_find());
@@ -109,6 +436,27 @@ class TestLRUCache {
         HELPER_TEST_CALL(test_put_multiple());
         HELPER_TEST_CALL(test_put_multiple_over());
         HELPER_TEST_CALL(test_get());
+        HELPER_TEST_CALL(test_get_then_put_over());
+        HELPER_TEST_CALL(test_weighted_construct());
+        HELPER_TEST_CALL(test_weighted_put());
+        HELPER_TEST_CALL(test_weighted_and_sized());
+        HELPER_TEST_CALL(test_throwing_weigher());
+        HELPER_TEST_CALL(test_get_or_compute());
+        HELPER_TEST_CALL(test_erase());
+        HELPER_TEST_CALL(test_try_get());
+        HELPER_TEST_CALL(test_many());
+        HELPER_TEST_CALL(test_heterogeneous_lookup());
+        HELPER_TEST_CALL(test_move_only());
+        HELPER_TEST_CALL(test_emplace());
+        HELPER_TEST_CALL(test_no_copies());
+        HELPER_TEST_CALL(test_snapshot());
+        HELPER_TEST_CALL(test_snapshot_expiry());
+        HELPER_TEST_CALL(test_time_to_live());
+        HELPER_TEST_CALL(test_expire());
+#ifndef HELPER_DISABLE_CACHE_STATISTICS
+        HELPER_TEST_CALL(test_statistics());
+        HELPER_TEST_CALL(test_latency_sampling());
+#endif
     }
 
 };
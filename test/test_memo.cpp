@@ -0,0 +1,151 @@
+/***************************************************************************
+ *            test_memo.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "memo.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+class TestMemo {
+  public:
+
+    void test_chain() {
+        size_t b_calls = 0, c_calls = 0;
+        MemoInput<int> a(1);
+        Memo<int> b([&]{ ++b_calls; return a()*2; });
+        Memo<int> c([&]{ ++c_calls; return b()+1; });
+        HELPER_TEST_ASSERT(c.is_dirty());
+        HELPER_TEST_EQUALS(c(),3);
+        HELPER_TEST_EQUALS(c(),3);
+        HELPER_TEST_EQUALS(b_calls,1);
+        HELPER_TEST_EQUALS(c_calls,1);
+        HELPER_TEST_EQUALS(a.number_of_dependents(),1);
+        HELPER_TEST_EQUALS(b.number_of_dependents(),1);
+        a.set(5);
+        HELPER_TEST_ASSERT(b.is_dirty());
+        HELPER_TEST_ASSERT(c.is_dirty());
+        HELPER_TEST_EQUALS(c(),11);
+        HELPER_TEST_EQUALS(b_calls,2);
+        HELPER_TEST_EQUALS(c_calls,2);
+    }
+
+    void test_only_dependents_invalidated() {
+        size_t x_calls = 0, y_calls = 0, sum_calls = 0;
+        MemoInput<int> a(1), b(10);
+        Memo<int> x([&]{ ++x_calls; return a()+1; });
+        Memo<int> y([&]{ ++y_calls; return b()+1; });
+        Memo<int> sum([&]{ ++sum_calls; return x()+y(); });
+        HELPER_TEST_EQUALS(sum(),13);
+        b.set(20);
+        HELPER_TEST_ASSERT(not x.is_dirty());
+        HELPER_TEST_ASSERT(y.is_dirty());
+        HELPER_TEST_ASSERT(sum.is_dirty());
+        HELPER_TEST_EQUALS(sum(),23);
+        HELPER_TEST_EQUALS(x_calls,1);
+        HELPER_TEST_EQUALS(y_calls,2);
+        HELPER_TEST_EQUALS(sum_calls,2);
+    }
+
+    void test_diamond() {
+        size_t top_calls = 0;
+        MemoInput<int> a(2);
+        Memo<int> left([&]{ return a()+1; });
+        Memo<int> right([&]{ return a()*3; });
+        Memo<int> top([&]{ ++top_calls; return left()*right(); });
+        HELPER_TEST_EQUALS(top(),18);
+        a.set(3);
+        HELPER_TEST_EQUALS(top(),36);
+        HELPER_TEST_EQUALS(top_calls,2);
+        HELPER_TEST_EQUALS(a.number_of_dependents(),2);
+    }
+
+    void test_dynamic_dependencies() {
+        MemoInput<bool> use_first(true);
+        MemoInput<std::string> first("first"), second("second");
+        Memo<std::string> chosen([&]{ return use_first() ? first() : second(); });
+        HELPER_TEST_EQUALS(chosen(),"first");
+        HELPER_TEST_EQUALS(second.number_of_dependents(),0);
+        second.set("other");
+        HELPER_TEST_ASSERT(not chosen.is_dirty());
+        use_first.set(false);
+        HELPER_TEST_EQUALS(chosen(),"other");
+        HELPER_TEST_EQUALS(first.number_of_dependents(),0);
+        HELPER_TEST_EQUALS(second.number_of_dependents(),1);
+        first.set("changed");
+        HELPER_TEST_ASSERT(not chosen.is_dirty());
+    }
+
+    void test_expired_dependent() {
+        MemoInput<int> a(1);
+        {
+            Memo<int> b([&]{ return a()+1; });
+            HELPER_TEST_EQUALS(b(),2);
+            HELPER_TEST_EQUALS(a.number_of_dependents(),1);
+        }
+        HELPER_TEST_EQUALS(a.number_of_dependents(),0);
+        a.set(2);
+    }
+
+    void test_failure() {
+        MemoInput<int> a(0);
+        Memo<int> b([&]{ if (a() == 0) throw std::runtime_error("zero input"); return 10/a(); });
+        HELPER_TEST_FAIL(b());
+        HELPER_TEST_ASSERT(b.is_dirty());
+        a.set(5);
+        HELPER_TEST_EQUALS(b(),2);
+    }
+
+    void test_cycle() {
+        Memo<int>* other = nullptr;
+        Memo<int> a([&]{ return (*other)()+1; });
+        Memo<int> b([&]{ return a()+1; });
+        other = &b;
+        HELPER_TEST_FAIL(a());
+        HELPER_TEST_ASSERT(a.is_dirty());
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_chain());
+        HELPER_TEST_CALL(test_only_dependents_invalidated());
+        HELPER_TEST_CALL(test_diamond());
+        HELPER_TEST_CALL(test_dynamic_dependencies());
+        HELPER_TEST_CALL(test_expired_dependent());
+        HELPER_TEST_CALL(test_failure());
+        HELPER_TEST_CALL(test_cycle());
+    }
+
+};
+
+int main() {
+    TestMemo().test();
+    return HELPER_TEST_FAILURES;
+}
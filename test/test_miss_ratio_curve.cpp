@@ -0,0 +1,142 @@
+/***************************************************************************
+ *            test_miss_ratio_curve.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lru_cache.hpp"
+#include "miss_ratio_curve.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+class TestMissRatioCurve {
+  public:
+
+    //! \brief A skewed trace of labels, with a fixed seed
+    std::vector<size_t> skewed_labels(size_t length, size_t universe) {
+        std::mt19937_64 engine(42);
+        std::uniform_real_distribution<double> distribution(0.0,1.0);
+        std::vector<size_t> result;
+        for (size_t i=0; i<length; ++i) result.push_back(static_cast<size_t>(static_cast<double>(universe)*std::pow(distribution(engine),3.0)));
+        return result;
+    }
+
+    //! \brief The miss ratio of an LRUCache of the given \a size over \a labels
+    double simulated_miss_ratio(std::vector<size_t> const& labels, size_t size) {
+        LRUCache<size_t,int> cache(size);
+        size_t misses = 0;
+        for (auto label : labels) {
+            if (cache.try_get(label) == nullptr) {
+                ++misses;
+                cache.put(label,0);
+            }
+        }
+        return static_cast<double>(misses)/static_cast<double>(labels.size());
+    }
+
+    std::vector<std::uint64_t> keys(std::vector<size_t> const& labels) {
+        std::vector<std::uint64_t> result;
+        for (auto label : labels) result.push_back(AccessTraceWriter::mix(std::hash<size_t>()(label)));
+        return result;
+    }
+
+    void test_record_trace() {
+        auto path = (std::filesystem::temp_directory_path() / "helper_test_miss_ratio_curve.trace").string();
+        std::filesystem::remove(path);
+        auto labels = skewed_labels(1000,100);
+        {
+            AccessTraceWriter writer(path);
+            LRUCache<size_t,int> cache(10);
+            cache.set_access_trace(&writer);
+            for (auto label : labels) cache.get_or_compute(label,[]{ return 0; });
+            cache.set_access_trace(nullptr);
+            cache.get_or_compute(labels[0],[]{ return 0; });
+            HELPER_TEST_EQUALS(writer.number_of_accesses(),labels.size());
+        }
+        {
+            AccessTraceWriter writer(path);
+            writer.record(std::hash<size_t>()(labels[0]));
+        }
+        AccessTraceReader reader(path);
+        HELPER_TEST_ASSERT(reader.is_valid());
+        HELPER_TEST_EQUALS(reader.keys().size(),labels.size()+1);
+        auto expected = keys(labels);
+        HELPER_TEST_ASSERT(std::equal(expected.begin(),expected.end(),reader.keys().begin()));
+        HELPER_TEST_EQUALS(reader.keys().back(),expected.front());
+        std::filesystem::remove(path);
+        {
+            AccessTraceWriter writer(path);
+            LRUCache<size_t,int> cache(10);
+            cache.set_access_trace(&writer);
+            for (auto label : labels) {
+                if (cache.has_label(label)) cache.get(label);
+                else cache.put(label,0);
+            }
+            HELPER_TEST_EQUALS(writer.number_of_accesses(),labels.size());
+        }
+        AccessTraceReader checked_reader(path);
+        HELPER_TEST_ASSERT(checked_reader.is_valid());
+        HELPER_TEST_ASSERT(std::equal(expected.begin(),expected.end(),checked_reader.keys().begin(),checked_reader.keys().end()));
+        std::filesystem::remove(path);
+        HELPER_TEST_ASSERT(not AccessTraceReader(path).is_valid());
+    }
+
+    void test_exact() {
+        auto labels = skewed_labels(5000,500);
+        MissRatioCurve curve(keys(labels),1.0);
+        HELPER_TEST_EQUALS(curve.number_of_sampled_accesses(),labels.size());
+        for (size_t size = 1; size <= 512; size *= 2)
+            HELPER_TEST_ASSERT(std::abs(curve.miss_ratio(size)-simulated_miss_ratio(labels,size)) < 1e-12);
+        HELPER_TEST_EQUALS(curve.miss_ratio(0),1.0);
+    }
+
+    void test_sampled() {
+        auto labels = skewed_labels(200000,20000);
+        MissRatioCurve curve(keys(labels),0.1);
+        HELPER_TEST_ASSERT(curve.number_of_sampled_accesses() < labels.size()/5);
+        for (size_t size = 256; size <= 16384; size *= 4)
+            HELPER_TEST_ASSERT(std::abs(curve.miss_ratio(size)-simulated_miss_ratio(labels,size)) < 0.03);
+        HELPER_TEST_FAIL(MissRatioCurve(keys(labels),0.0));
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_record_trace());
+        HELPER_TEST_CALL(test_exact());
+        HELPER_TEST_CALL(test_sampled());
+    }
+};
+
+int main() {
+    TestMissRatioCurve().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,121 @@
+/***************************************************************************
+ *            test_performance_counters.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <memory>
+#include <vector>
+#include "performance_counters.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+//! \brief A computation the compiler can't remove, touching \a num_pages fresh pages of memory
+size_t busy_work(size_t num_pages) {
+    size_t const page_size = 4096;
+    std::unique_ptr<char[]> memory(new char[num_pages*page_size]);
+    for (size_t i=0; i<num_pages; ++i) memory[i*page_size] = static_cast<char>(i);
+    volatile size_t sum = 0;
+    for (size_t i=0; i<num_pages; ++i) sum = sum + static_cast<size_t>(memory[i*page_size]);
+    for (size_t i=0; i<1000000; ++i) sum = sum + i;
+    return sum;
+}
+
+class TestPerformanceCounters {
+  public:
+
+    void test_names() {
+        HELPER_TEST_EQUALS(std::string(name(PerformanceEvent::CYCLES)),"cycles");
+        HELPER_TEST_EQUALS(std::string(name(PerformanceEvent::CONTEXT_SWITCHES)),"context switches");
+    }
+
+    void test_counts() {
+        PerformanceCounters counters;
+        HELPER_TEST_PRINT(counters.has_hardware_events())
+        HELPER_TEST_PRINT(counters.is_available(PerformanceEvent::TASK_CLOCK))
+        for (size_t i=0; i<NUMBER_OF_PERFORMANCE_EVENTS; ++i)
+            HELPER_TEST_EQUALS(counters.count(static_cast<PerformanceEvent>(i)),0);
+        busy_work(256);
+        counters.click();
+        HELPER_TEST_PRINT(counters)
+        if (counters.is_available(PerformanceEvent::TASK_CLOCK))
+            HELPER_TEST_ASSERT(counters.count(PerformanceEvent::TASK_CLOCK) > 0);
+        if (counters.is_available(PerformanceEvent::PAGE_FAULTS))
+            HELPER_TEST_ASSERT(counters.count(PerformanceEvent::PAGE_FAULTS) > 0);
+        if (counters.is_available(PerformanceEvent::INSTRUCTIONS))
+            HELPER_TEST_ASSERT(counters.count(PerformanceEvent::INSTRUCTIONS) >= 1000000);
+        if (not counters.is_available(PerformanceEvent::CYCLES))
+            HELPER_TEST_EQUALS(counters.count(PerformanceEvent::CYCLES),0);
+    }
+
+    void test_context_switches() {
+        PerformanceCounters counters;
+        for (size_t i=0; i<20; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        counters.click();
+        HELPER_TEST_PRINT(counters)
+        if (counters.is_available(PerformanceEvent::CONTEXT_SWITCHES))
+            HELPER_TEST_ASSERT(counters.count(PerformanceEvent::CONTEXT_SWITCHES) > 0);
+    }
+
+    void test_restart() {
+        PerformanceCounters counters;
+        busy_work(64);
+        counters.click();
+        auto before = counters.count(PerformanceEvent::TASK_CLOCK);
+        counters.restart();
+        HELPER_TEST_EQUALS(counters.count(PerformanceEvent::TASK_CLOCK),0);
+        counters.click();
+        HELPER_TEST_ASSERT(counters.count(PerformanceEvent::TASK_CLOCK) <= before);
+    }
+
+    void test_multiple_groups() {
+        std::vector<std::unique_ptr<PerformanceCounters>> groups;
+        for (size_t i=0; i<4; ++i) groups.push_back(std::make_unique<PerformanceCounters>());
+        busy_work(16);
+        for (auto& group : groups) group->click();
+        for (auto& group : groups)
+            if (group->is_available(PerformanceEvent::TASK_CLOCK))
+                HELPER_TEST_ASSERT(group->count(PerformanceEvent::TASK_CLOCK) > 0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_names());
+        HELPER_TEST_CALL(test_counts());
+        HELPER_TEST_CALL(test_context_switches());
+        HELPER_TEST_CALL(test_restart());
+        HELPER_TEST_CALL(test_multiple_groups());
+    }
+
+};
+
+int main() {
+    TestPerformanceCounters().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,151 @@
+/***************************************************************************
+ *            test_persistent_lazy.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "persistent_lazy.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+struct StringSerializer {
+    void serialize(std::string const& str, std::string& buffer) const { buffer.append(str); }
+    std::string deserialize(std::string_view bytes) const { return std::string(bytes); }
+};
+
+template<class T> concept Addable = requires(MemoKey key, T input) { key.add(input); };
+
+struct Packed { std::uint32_t a, b; };
+struct Padded { std::uint8_t a; std::uint32_t b; };
+enum class Color : std::uint8_t { red, green };
+
+class TestPersistentLazy {
+  public:
+    TestPersistentLazy() : _directory((std::filesystem::temp_directory_path() / "helper_test_persistent_lazy").string()) {
+        std::filesystem::remove_all(_directory);
+    }
+    ~TestPersistentLazy() {
+        std::filesystem::remove_all(_directory);
+    }
+
+    void test_key() {
+        HELPER_TEST_ASSERT(MemoKey("f").add("ab").add("c").bytes() != MemoKey("f").add("a").add("bc").bytes());
+        HELPER_TEST_ASSERT(MemoKey("f").add(1).file_name() != MemoKey("f").add(2).file_name());
+        HELPER_TEST_EQUALS(MemoKey("f").add(1.5).file_name(),MemoKey("f").add(1.5).file_name());
+        HELPER_TEST_EQUALS(MemoKey("f").add(std::string("x")).bytes(),MemoKey("f").add("x").bytes());
+        static_assert(Addable<Packed> and Addable<double> and Addable<Color>);
+        static_assert(not Addable<Padded> and not Addable<int*>);
+    }
+
+    void test_reuse() {
+        size_t calls = 0;
+        auto create = [&](int input) {
+            return make_persistent_lazy<double>(MemoKey("square").add(input), [&calls,input]{ ++calls; return double(input*input); }, _directory);
+        };
+        auto first = create(3);
+        HELPER_TEST_EQUALS(first(),9.0);
+        HELPER_TEST_EQUALS(calls,1);
+        HELPER_TEST_ASSERT(std::filesystem::exists(memo_path(_directory,MemoKey("square").add(3))));
+        auto second = create(3);
+        HELPER_TEST_EQUALS(second(),9.0);
+        HELPER_TEST_EQUALS(calls,1);
+        auto other = create(4);
+        HELPER_TEST_EQUALS(other(),16.0);
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_serializer() {
+        size_t calls = 0;
+        auto create = [&]{
+            return make_persistent_lazy<std::string,StringSerializer>(MemoKey("greeting").add("world"), [&calls]{ ++calls; return std::string("hello world"); }, _directory);
+        };
+        HELPER_TEST_EQUALS(create()(),"hello world");
+        HELPER_TEST_EQUALS(create()(),"hello world");
+        HELPER_TEST_EQUALS(calls,1);
+    }
+
+    void test_corrupt() {
+        size_t calls = 0;
+        MemoKey key("corrupt");
+        auto create = [&]{ return make_persistent_lazy<int>(key, [&calls]{ ++calls; return 42; }, _directory); };
+        HELPER_TEST_EQUALS(create()(),42);
+        {
+            std::ofstream stream(memo_path(_directory,key), std::ios::binary | std::ios::trunc);
+            stream << "not a snapshot";
+        }
+        HELPER_TEST_EQUALS(create()(),42);
+        HELPER_TEST_EQUALS(calls,2);
+        HELPER_TEST_EQUALS(create()(),42);
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_mismatch() {
+        size_t calls = 0;
+        MemoKey key("mismatch");
+        HELPER_TEST_EQUALS((make_persistent_lazy<double>(key, [&calls]{ ++calls; return 1.0; }, _directory)()),1.0);
+        HELPER_TEST_EQUALS((make_persistent_lazy<int>(key, [&calls]{ ++calls; return 2; }, _directory)()),2);
+        HELPER_TEST_EQUALS(calls,2);
+    }
+
+    void test_concurrent_stores() {
+        MemoKey key("concurrent");
+        std::string value(100000, 'x');
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<8; ++t)
+            threads.emplace_back([&]{ for (size_t i=0; i<10; ++i) store_memo(_directory, key, value); });
+        for (auto& thread : threads) thread.join();
+        SnapshotReader reader(memo_path(_directory,key), 0);
+        HELPER_TEST_ASSERT(reader.is_valid());
+        HELPER_TEST_EQUALS(reader.records().front().value.size(),value.size());
+        for (auto const& entry : std::filesystem::directory_iterator(_directory))
+            HELPER_TEST_ASSERT(entry.path().extension() != ".tmp");
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_key());
+        HELPER_TEST_CALL(test_reuse());
+        HELPER_TEST_CALL(test_serializer());
+        HELPER_TEST_CALL(test_corrupt());
+        HELPER_TEST_CALL(test_mismatch());
+        HELPER_TEST_CALL(test_concurrent_stores());
+    }
+
+  private:
+    std::string _directory;
+};
+
+int main() {
+    TestPersistentLazy().test();
+    return HELPER_TEST_FAILURES;
+}
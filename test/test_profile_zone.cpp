@@ -0,0 +1,156 @@
+/***************************************************************************
+ *            test_profile_zone.cpp
+ *
+ *  Copyright  2023  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "profile_zone.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+using namespace std::chrono_literals;
+
+class TestProfileZone {
+  public:
+
+    void test_call_tree() {
+        ZoneProfiler profiler;
+        profiler.enter("outer");
+        for (size_t i=0; i<3; ++i) {
+            profiler.enter("inner");
+            std::this_thread::sleep_for(2ms);
+            profiler.exit();
+        }
+        profiler.enter("other");
+        profiler.exit();
+        std::this_thread::sleep_for(2ms);
+        profiler.exit();
+        profiler.enter("outer");
+        profiler.exit();
+
+        auto tree = profiler.call_tree();
+        HELPER_TEST_PRINT(tree)
+        HELPER_TEST_EQUALS(tree.children.size(),1);
+        auto outer = tree.child("outer");
+        HELPER_TEST_ASSERT(outer != nullptr);
+        HELPER_TEST_EQUALS(outer->calls,2);
+        HELPER_TEST_EQUALS(outer->children.size(),2);
+        auto inner = outer->child("inner");
+        HELPER_TEST_EQUALS(inner->calls,3);
+        HELPER_TEST_ASSERT(inner->inclusive_time >= 6000000);
+        HELPER_TEST_EQUALS(inner->exclusive_time,inner->inclusive_time);
+        HELPER_TEST_EQUALS(outer->child("other")->calls,1);
+        HELPER_TEST_EQUALS(outer->exclusive_time,outer->inclusive_time-inner->inclusive_time-outer->child("other")->inclusive_time);
+        HELPER_TEST_ASSERT(outer->exclusive_time >= 2000000);
+    }
+
+    void test_open_zones() {
+        ZoneProfiler profiler;
+        profiler.enter("open");
+        profiler.enter("closed");
+        profiler.exit();
+        auto tree = profiler.call_tree();
+        HELPER_TEST_EQUALS(tree.child("open")->calls,0);
+        HELPER_TEST_EQUALS(tree.child("open")->child("closed")->calls,1);
+        profiler.exit();
+        HELPER_TEST_EQUALS(profiler.call_tree().child("open")->calls,1);
+    }
+
+    void test_blocks() {
+        ZoneProfiler profiler;
+        size_t const num_calls = 5000;
+        for (size_t i=0; i<num_calls; ++i) { profiler.enter("zone"); profiler.exit(); }
+        auto events = profiler.events();
+        HELPER_TEST_EQUALS(events.size(),1);
+        HELPER_TEST_EQUALS(events.front().events.size(),2*num_calls);
+        HELPER_TEST_EQUALS(profiler.call_tree().child("zone")->calls,num_calls);
+        profiler.clear();
+        HELPER_TEST_ASSERT(profiler.events().empty());
+        profiler.enter("zone");
+        profiler.exit();
+        HELPER_TEST_EQUALS(profiler.call_tree().child("zone")->calls,1);
+    }
+
+    void test_threads() {
+        ZoneProfiler profiler;
+        size_t const num_threads = 4;
+        size_t const num_calls = 2000;
+        std::vector<std::thread> threads;
+        for (size_t t=0; t<num_threads; ++t) {
+            threads.emplace_back([&profiler]{
+                for (size_t i=0; i<num_calls; ++i) {
+                    profiler.enter("work");
+                    profiler.enter("step");
+                    profiler.exit();
+                    profiler.exit();
+                }
+            });
+        }
+        auto partial = profiler.call_tree();
+        for (auto& thread : threads) thread.join();
+        HELPER_TEST_EQUALS(profiler.events().size(),num_threads);
+        auto tree = profiler.call_tree();
+        HELPER_TEST_EQUALS(tree.child("work")->calls,num_threads*num_calls);
+        HELPER_TEST_EQUALS(tree.child("work")->child("step")->calls,num_threads*num_calls);
+    }
+
+    void test_scope() {
+        ZoneProfiler::instance().clear();
+        {
+            HELPER_PROFILE_SCOPE("scope");
+            HELPER_PROFILE_SCOPE("nested");
+        }
+        auto tree = ZoneProfiler::instance().call_tree();
+#ifndef HELPER_DISABLE_PROFILE_ZONES
+        HELPER_TEST_EQUALS(tree.child("scope")->calls,1);
+        HELPER_TEST_EQUALS(tree.child("scope")->child("nested")->calls,1);
+#else
+        HELPER_TEST_ASSERT(tree.children.empty());
+#endif
+        std::ostringstream os;
+        os << tree;
+        HELPER_TEST_PRINT(os.str())
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_call_tree());
+        HELPER_TEST_CALL(test_open_zones());
+        HELPER_TEST_CALL(test_blocks());
+        HELPER_TEST_CALL(test_threads());
+        HELPER_TEST_CALL(test_scope());
+    }
+
+};
+
+int main() {
+    TestProfileZone().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,159 @@
+/***************************************************************************
+ *            test_read_mostly_cache.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "string.hpp"
+#include "read_mostly_cache.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+using CacheType = ReadMostlyCache<String,int>;
+
+class TestReadMostlyCache {
+  public:
+
+    void test_construct() {
+        HELPER_TEST_FAIL(CacheType(0));
+        CacheType cache(4);
+        HELPER_TEST_EQUALS(cache.current_size(),0);
+        HELPER_TEST_EQUALS(cache.maximum_size(),4);
+    }
+
+    void test_put_get() {
+        CacheType cache(4);
+        HELPER_TEST_ASSERT(not cache.has_label("first"));
+        HELPER_TEST_FAIL(cache.get("first"));
+        HELPER_TEST_ASSERT(not cache.try_get("first").has_value());
+        cache.put("first",42);
+        HELPER_TEST_ASSERT(cache.has_label("first"));
+        HELPER_TEST_EQUALS(cache.get("first"),42);
+        HELPER_TEST_FAIL(cache.put("first",10));
+        HELPER_TEST_EQUALS(cache.get_or_compute("first",[]{ return 10; }),42);
+        HELPER_TEST_EQUALS(cache.get_or_compute("second",[]{ return 10; }),10);
+        HELPER_TEST_EQUALS(cache.current_size(),2);
+    }
+
+    void test_erase() {
+        CacheType cache(3);
+        cache.put("first",1);
+        cache.put("second",2);
+        cache.put("third",3);
+        HELPER_TEST_ASSERT(cache.erase("first"));
+        HELPER_TEST_ASSERT(not cache.erase("first"));
+        HELPER_TEST_EQUALS(cache.current_size(),2);
+        HELPER_TEST_EQUALS(cache.get("third"),3);
+        cache.put("first",4);
+        HELPER_TEST_EQUALS(cache.get("first"),4);
+        HELPER_TEST_EQUALS(cache.get("second"),2);
+    }
+
+    void test_clock_eviction() {
+        CacheType cache(3);
+        cache.put("first",1);
+        cache.put("second",2);
+        cache.put("third",3);
+        cache.get("first");
+        cache.put("fourth",4);
+        HELPER_TEST_ASSERT(cache.has_label("first"));
+        HELPER_TEST_ASSERT(not cache.has_label("second"));
+        HELPER_TEST_EQUALS(cache.current_size(),3);
+    }
+
+    void test_churn() {
+        ReadMostlyCache<size_t,size_t> cache(64);
+        for (size_t i=0; i<10000; ++i) {
+            cache.put(i,2*i);
+            if (i%3 == 1) cache.erase(i);
+        }
+        HELPER_TEST_EQUALS(cache.current_size(),64);
+        size_t found = 0;
+        for (size_t i=0; i<10000; ++i) {
+            auto val = cache.try_get(i);
+            if (val.has_value()) {
+                ++found;
+                HELPER_TEST_EQUALS(val.value(),2*i);
+            }
+        }
+        HELPER_TEST_EQUALS(found,64);
+    }
+
+    void test_concurrent_readers_and_writer() {
+        size_t const num_readers = 4;
+        size_t const num_labels = 256;
+        ReadMostlyCache<size_t,std::vector<size_t>> cache(num_labels/2);
+        std::atomic<bool> done = false;
+        std::atomic<size_t> mismatches = 0;
+        std::atomic<size_t> hits = 0;
+        std::vector<std::thread> readers;
+        for (size_t t=0; t<num_readers; ++t) {
+            readers.emplace_back([&,t]{
+                // Readers may be scheduled only after the writer is done, hence they keep reading until they get a hit
+                size_t own_hits = 0;
+                for (size_t i=t; not done.load() or own_hits == 0; ++i) {
+                    auto val = cache.try_get(i%num_labels);
+                    if (not val.has_value()) continue;
+                    ++own_hits;
+                    ++hits;
+                    if (val->size() != 16 or val->front() != i%num_labels or val->back() != i%num_labels) ++mismatches;
+                }
+            });
+        }
+        for (size_t i=0; i<20000; ++i) {
+            size_t label = (i*7)%num_labels;
+            if (not cache.erase(label)) cache.put(label,std::vector<size_t>(16,label));
+        }
+        if (not cache.has_label(0)) cache.put(0,std::vector<size_t>(16,0));
+        done = true;
+        for (auto& reader : readers) reader.join();
+        HELPER_TEST_EQUALS(mismatches,0);
+        HELPER_TEST_ASSERT(hits > 0);
+        EpochDomain::instance().reclaim();
+        HELPER_TEST_EQUALS(EpochDomain::instance().number_of_retired(),0);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_construct());
+        HELPER_TEST_CALL(test_put_get());
+        HELPER_TEST_CALL(test_erase());
+        HELPER_TEST_CALL(test_clock_eviction());
+        HELPER_TEST_CALL(test_churn());
+        HELPER_TEST_CALL(test_concurrent_readers_and_writer());
+    }
+
+};
+
+int main() {
+    TestReadMostlyCache().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -50,9 +50,42 @@ class TestStopwatch {
         HELPER_TEST_ASSERT(sw.elapsed_seconds() > 0.01);
     }
 
+    void test_cycle_clock() {
+        HELPER_TEST_PRINT(CycleClock::uses_time_stamp_counter())
+        HELPER_TEST_PRINT(CycleClock::ticks_per_second())
+        HELPER_TEST_ASSERT(CycleClock::uses_time_stamp_counter() == (CycleClock::ticks_per_second() > 0.0));
+        auto steady = std::chrono::steady_clock::now().time_since_epoch();
+        auto cycle = CycleClock::now().time_since_epoch();
+        HELPER_TEST_ASSERT(std::chrono::abs(cycle-steady) < 10ms);
+        auto previous = CycleClock::now();
+        for (size_t i=0; i<1000; ++i) {
+            auto current = CycleClock::now();
+            HELPER_TEST_ASSERT(current >= previous);
+            previous = current;
+        }
+    }
+
+    void test_cycle_duration() {
+        // The cycle stopwatch is bracketed by reference ones, allowing for a small calibration error
+        Stopwatch<Microseconds> outer;
+        CycleStopwatch<Microseconds> sw;
+        Stopwatch<Microseconds> inner;
+        std::this_thread::sleep_for(10ms);
+        inner.click();
+        sw.click();
+        outer.click();
+        auto duration = sw.duration();
+        HELPER_TEST_ASSERT(duration.count()>=10000);
+        HELPER_TEST_ASSERT(sw.elapsed_seconds() >= 0.01);
+        HELPER_TEST_ASSERT(duration <= outer.duration() + outer.duration()/100 + 10us);
+        HELPER_TEST_ASSERT(duration >= inner.duration() - inner.duration()/100 - 10us);
+    }
+
     void test() {
         HELPER_TEST_CALL(test_create());
         HELPER_TEST_CALL(test_duration());
+        HELPER_TEST_CALL(test_cycle_clock());
+        HELPER_TEST_CALL(test_cycle_duration());
     }
 
 };
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *            test_thread_pool.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+
+#include "thread_pool.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+
+class TestThreadPool {
+  public:
+
+    void test_construct() {
+        HELPER_TEST_FAIL(ThreadPool(0));
+        ThreadPool pool(3);
+        HELPER_TEST_EQUALS(pool.num_threads(),3);
+        HELPER_TEST_EQUALS(pool.queue_size(),0);
+        HELPER_TEST_ASSERT(ThreadPool::global().num_threads() > 0);
+    }
+
+    void test_run_all_tasks() {
+        std::atomic<size_t> count = 0;
+        {
+            ThreadPool pool(4);
+            for (size_t i=0; i<1000; ++i) pool.enqueue([&count]{ ++count; });
+        }
+        HELPER_TEST_EQUALS(count,1000);
+    }
+
+    void test_failing_task() {
+        std::atomic<size_t> count = 0;
+        {
+            ThreadPool pool(1);
+            pool.enqueue([]{ throw std::runtime_error("discarded"); });
+            pool.enqueue([&count]{ ++count; });
+        }
+        HELPER_TEST_EQUALS(count,1);
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_construct());
+        HELPER_TEST_CALL(test_run_all_tasks());
+        HELPER_TEST_CALL(test_failing_task());
+    }
+
+};
+
+int main() {
+    TestThreadPool().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,199 @@
+/***************************************************************************
+ *            test_timer_wheel.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "timer_wheel.hpp"
+
+#include "test.hpp"
+
+using namespace Helper;
+using namespace std::chrono_literals;
+
+using WheelType = TimerWheel<int>;
+
+class TestTimerWheel {
+  public:
+
+    TestTimerWheel() : _start(WheelType::ClockType::now()) { }
+
+    std::vector<int> advance(WheelType& wheel, WheelType::DurationType elapsed) {
+        std::vector<int> result;
+        wheel.advance(_start+elapsed,[&result](int key){ result.push_back(key); });
+        return result;
+    }
+
+    void test_construct() {
+        HELPER_TEST_FAIL(WheelType(0ms,_start));
+        WheelType wheel(1ms,_start);
+        HELPER_TEST_ASSERT(wheel.empty());
+        HELPER_TEST_EQUALS(wheel.size(),0);
+    }
+
+    void test_schedule_cancel() {
+        WheelType wheel(1ms,_start);
+        wheel.schedule(1,_start+10ms);
+        wheel.schedule(2,_start+20ms);
+        HELPER_TEST_EQUALS(wheel.size(),2);
+        HELPER_TEST_ASSERT(wheel.contains(1));
+        wheel.cancel(1);
+        wheel.cancel(3);
+        HELPER_TEST_ASSERT(not wheel.contains(1));
+        HELPER_TEST_EQUALS(wheel.size(),1);
+        HELPER_TEST_EQUALS(advance(wheel,30ms).size(),1);
+        HELPER_TEST_ASSERT(wheel.empty());
+    }
+
+    void test_expire_first_level() {
+        WheelType wheel(1ms,_start);
+        wheel.schedule(1,_start+5ms);
+        wheel.schedule(2,_start+10ms);
+        HELPER_TEST_EQUALS(advance(wheel,4ms).size(),0);
+        auto expired = advance(wheel,5ms);
+        HELPER_TEST_EQUALS(expired.size(),1);
+        HELPER_TEST_EQUALS(expired[0],1);
+        HELPER_TEST_EQUALS(advance(wheel,9ms).size(),0);
+        HELPER_TEST_EQUALS(advance(wheel,10ms).size(),1);
+    }
+
+    void test_expire_higher_levels() {
+        WheelType wheel(1ms,_start);
+        std::vector<std::chrono::milliseconds> deadlines = {100ms, 4095ms, 4096ms, 300000ms, 20000000ms};
+        for (size_t i=0; i<deadlines.size(); ++i) wheel.schedule(static_cast<int>(i),_start+deadlines[i]);
+        for (size_t i=0; i<deadlines.size(); ++i) {
+            HELPER_TEST_EQUALS(advance(wheel,deadlines[i]-1ms).size(),0);
+            auto expired = advance(wheel,deadlines[i]);
+            HELPER_TEST_EQUALS(expired.size(),1);
+            HELPER_TEST_EQUALS(expired[0],static_cast<int>(i));
+        }
+        HELPER_TEST_ASSERT(wheel.empty());
+    }
+
+    void test_reschedule() {
+        WheelType wheel(1ms,_start);
+        wheel.schedule(1,_start+10ms);
+        wheel.schedule(1,_start+100ms);
+        HELPER_TEST_EQUALS(wheel.size(),1);
+        HELPER_TEST_EQUALS(advance(wheel,50ms).size(),0);
+        HELPER_TEST_EQUALS(advance(wheel,100ms).size(),1);
+    }
+
+    void test_past_deadline() {
+        WheelType wheel(1ms,_start);
+        advance(wheel,10ms);
+        wheel.schedule(1,_start+5ms);
+        HELPER_TEST_EQUALS(advance(wheel,11ms).size(),1);
+    }
+
+    void test_rounding() {
+        WheelType wheel(10ms,_start);
+        wheel.schedule(1,_start+15ms);
+        HELPER_TEST_EQUALS(advance(wheel,15ms).size(),0);
+        HELPER_TEST_EQUALS(advance(wheel,20ms).size(),1);
+    }
+
+    void test_long_gap() {
+        WheelType wheel(1ms,_start);
+        wheel.schedule(1,_start+48h);
+        wheel.schedule(2,_start+24h+5ms);
+        auto begin = std::chrono::steady_clock::now();
+        HELPER_TEST_EQUALS(advance(wheel,24h).size(),0);
+        HELPER_TEST_EQUALS(advance(wheel,24h+4ms).size(),0);
+        auto expired = advance(wheel,24h+5ms);
+        HELPER_TEST_EQUALS(expired.size(),1);
+        HELPER_TEST_EQUALS(expired[0],2);
+        HELPER_TEST_EQUALS(advance(wheel,48h-1ms).size(),0);
+        expired = advance(wheel,48h);
+        HELPER_TEST_EQUALS(expired.size(),1);
+        HELPER_TEST_EQUALS(expired[0],1);
+        auto elapsed = std::chrono::steady_clock::now()-begin;
+        HELPER_TEST_PRINT(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count())
+        HELPER_TEST_ASSERT(elapsed < 100ms);
+    }
+
+    void test_many_deadlines() {
+        WheelType wheel(1ms,_start);
+        std::vector<std::chrono::milliseconds> deadlines;
+        for (int i=0; i<2000; ++i) {
+            auto deadline = std::chrono::milliseconds((static_cast<long>(i)*7919*7919) % 20000000 + 1);
+            deadlines.push_back(deadline);
+            wheel.schedule(i,_start+deadline);
+        }
+        std::vector<std::chrono::milliseconds> expiry(deadlines.size());
+        for (std::chrono::milliseconds now = 0ms; not wheel.empty(); now += 997ms)
+            wheel.advance(_start+now,[&](int key){ expiry[static_cast<size_t>(key)] = now; });
+        for (size_t i=0; i<deadlines.size(); ++i) {
+            HELPER_TEST_ASSERT(expiry[i] >= deadlines[i]);
+            HELPER_TEST_ASSERT(expiry[i] < deadlines[i]+997ms);
+        }
+    }
+
+    void test_cancel_on_expire() {
+        WheelType wheel(1ms,_start);
+        wheel.schedule(1,_start+5ms);
+        wheel.schedule(2,_start+5ms);
+        wheel.schedule(3,_start+5ms);
+        std::vector<int> expired;
+        wheel.advance(_start+5ms,[&](int key){
+            expired.push_back(key);
+            if (expired.size() == 1) {
+                for (int other = 1; other <= 3; ++other) wheel.cancel(other);
+                wheel.schedule(key == 3 ? 2 : 3,_start+8ms);
+            }
+        });
+        HELPER_TEST_EQUALS(expired.size(),1);
+        HELPER_TEST_EQUALS(wheel.size(),1);
+        auto later = advance(wheel,8ms);
+        HELPER_TEST_EQUALS(later.size(),1);
+        HELPER_TEST_ASSERT(later[0] != expired[0]);
+        HELPER_TEST_ASSERT(wheel.empty());
+    }
+
+    void test() {
+        HELPER_TEST_CALL(test_construct());
+        HELPER_TEST_CALL(test_schedule_cancel());
+        HELPER_TEST_CALL(test_expire_first_level());
+        HELPER_TEST_CALL(test_expire_higher_levels());
+        HELPER_TEST_CALL(test_reschedule());
+        HELPER_TEST_CALL(test_past_deadline());
+        HELPER_TEST_CALL(test_rounding());
+        HELPER_TEST_CALL(test_long_gap());
+        HELPER_TEST_CALL(test_many_deadlines());
+        HELPER_TEST_CALL(test_cancel_on_expire());
+    }
+
+  private:
+    WheelType::TimePointType const _start;
+};
+
+int main() {
+    TestTimerWheel().test();
+    return HELPER_TEST_FAILURES;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *            replay_trace.cpp
+ *
+ *  Copyright  2026  Luca Geretti
+ *
+ ****************************************************************************/
+
+/*
+ * This file is part of Helper, under the MIT license.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*! \file replay_trace.cpp
+ *  \brief Print the estimated miss ratio curve of a trace recorded by AccessTraceWriter
+ *  \details Usage: replay_trace TRACE [SAMPLING_RATE]. Cache sizes double from one up to the estimated number of distinct keys.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "access_trace.hpp"
+#include "miss_ratio_curve.hpp"
+
+using namespace Helper;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 or argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " TRACE [SAMPLING_RATE]" << std::endl;
+        return 1;
+    }
+    AccessTraceReader trace(argv[1]);
+    if (not trace.is_valid()) {
+        std::cerr << "Invalid trace file " << argv[1] << std::endl;
+        return 1;
+    }
+    double sampling_rate = 0.01;
+    try {
+        if (argc == 3) sampling_rate = std::stod(argv[2]);
+    } catch (std::exception const&) {
+        std::cerr << "Invalid sampling rate " << argv[2] << std::endl;
+        return 1;
+    }
+    if (not (sampling_rate > 0 and sampling_rate <= 1)) {
+        std::cerr << "The sampling rate must be in (0,1]" << std::endl;
+        return 1;
+    }
+
+    MissRatioCurve curve(trace.keys(), sampling_rate);
+    std::cout << "Accesses: " << curve.number_of_accesses() << ", sampled: " << curve.number_of_sampled_accesses()
+              << ", estimated distinct labels: " << curve.number_of_distinct_keys() << std::endl;
+    std::cout << std::setw(16) << "Cache size" << std::setw(16) << "Miss ratio" << std::endl;
+    for (size_t size = 1; ; size *= 2) {
+        std::cout << std::setw(16) << size << std::setw(16) << std::fixed << std::setprecision(4) << curve.miss_ratio(size) << std::endl;
+        if (size >= curve.number_of_distinct_keys()) break;
+    }
+    return 0;
+}